@@ -0,0 +1,100 @@
+#include "tensor.hpp"
+#include <chrono>
+#include <cstdlib>
+#include <functional>
+#include <iomanip>
+#include <iostream>
+#include <vector>
+
+using T = double;
+using namespace tensor::ops;
+
+/// PINN for the 2d Laplace problem, with the forward-Laplacian pass
+const std::vector<size_t> widths{2, 20, 20, 20, 1};
+
+/**
+ * Epochs to tolerance of AdaHessian against Adam.
+ *
+ * Solves the 2d Laplace problem with exact solution x^2 - y^2 on N interior
+ * and N / 4 boundary points, full batch, from the same initialization, and
+ * reports for every optimizer, learning rate and power of the preconditioner
+ * (the square root of the second moment for Adam) the first epoch at which
+ * the total loss falls below the tolerance. Both optimizers pay the same
+ * backward: the Hessian diagonal used by AdaHessian is propagated into the
+ * parameters by every backward pass.
+ *
+ * Usage: ./adahessian_benchmark [tolerance] [max_epochs] [N]
+ */
+int main(int argc, char **argv) {
+    const T tolerance = argc > 1 ? std::strtod(argv[1], nullptr) : 1e-3;
+    const int max_epochs = argc > 2 ? std::atoi(argv[2]) : 3000;
+    const size_t N = argc > 3 ? std::strtoul(argv[3], nullptr, 10) : 256;
+    const size_t Nb = N / 4;
+
+    tensor::set_seed(5);
+    auto x = tensor::uniform<T>({N, 2}, -1.0, 1.0);
+    auto xb = tensor::uniform<T>({Nb, 2}, -1.0, 1.0);
+    auto yb = tensor::zeros<T>({Nb, 1});
+    for (size_t i = 0; i < Nb; ++i) {
+        // One side of the square per quarter of the boundary points
+        xb->data[2 * i + (i * 4 / Nb) / 2] = (i * 4 / Nb) % 2 ? 1.0 : -1.0;
+        const T bx = xb->data[2 * i], by = xb->data[2 * i + 1];
+        yb->data[i] = bx * bx - by * by;
+    }
+
+    tensor::nn::MLP<T> initial(widths, 0.3);
+    using Factory = std::function<std::unique_ptr<tensor::optim::Optimizer<T>>(const std::vector<TensorS<T>> &)>;
+    struct Run {
+        const char *name;
+        T lr, power;
+        Factory make;
+    };
+    auto adam = [](T lr) {
+        return [lr](const std::vector<TensorS<T>> &p) {
+            return std::make_unique<tensor::optim::Adam<T>>(p, lr, 0.9, 0.999, 1e-8, 0.0);
+        };
+    };
+    auto adahessian = [](T lr, T power) {
+        return [lr, power](const std::vector<TensorS<T>> &p) {
+            return std::make_unique<tensor::optim::AdaHessian<T>>(p, lr, 0.9, 0.999, 1e-4, 0.0, power);
+        };
+    };
+    std::vector<Run> runs = {
+            {"Adam", 1e-3, 0.5, adam(1e-3)},
+            {"Adam", 1e-2, 0.5, adam(1e-2)},
+            {"AdaHessian", 1e-2, 1.0, adahessian(1e-2, 1.0)},
+            {"AdaHessian", 3e-2, 0.5, adahessian(3e-2, 0.5)},
+            {"AdaHessian", 3e-2, 1.0, adahessian(3e-2, 1.0)},
+    };
+
+    std::cout << "Tolerance: " << tolerance << ", points: " << N << " + " << Nb << "\n";
+    std::cout << std::setw(12) << "optimizer" << std::setw(10) << "lr" << std::setw(8) << "power"
+              << std::setw(10) << "epochs" << std::setw(10) << "seconds" << std::setw(14) << "final loss\n";
+
+    for (auto &run: runs) {
+        tensor::nn::MLP<T> net(widths, 0.3);
+        tensor::nn::copy_params(initial, net);
+        auto optim = run.make(net.getParams());
+
+        auto start = std::chrono::steady_clock::now();
+        int epoch = 0;
+        T loss_value = 0;
+        for (; epoch < max_epochs; ++epoch) {
+            optim->zero_grad();
+            auto loss = mean(pow(tensor::nn::laplacian(net, x), 2)) + mean(pow(net(xb) - yb, 2));
+            loss_value = loss->data[0];
+            if (loss_value < tolerance) break;
+            loss->backward();
+            optim->step();
+        }
+        double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+        std::cout << std::setw(12) << run.name << std::setw(10) << run.lr << std::setw(8) << run.power << std::setw(10);
+        if (epoch < max_epochs) std::cout << epoch;
+        else std::cout << ">" + std::to_string(max_epochs);
+        std::cout << std::setw(10) << std::fixed << std::setprecision(2) << seconds
+                  << std::setw(13) << std::scientific << std::setprecision(3) << loss_value << "\n";
+        std::cout.unsetf(std::ios::floatfield);
+    }
+    return 0;
+}
@@ -0,0 +1,106 @@
+#include "tensor.hpp"
+#include <chrono>
+#include <cstdlib>
+#include <iomanip>
+#include <iostream>
+#include <random>
+#include <vector>
+
+using T = double;
+using namespace tensor::ops;
+namespace par = tensor::parallel;
+
+/// Small PINN-sized network (about 2k parameters)
+const std::vector<size_t> widths{2, 40, 40, 1};
+
+/**
+ * Convergence and throughput of Hogwild against synchronous data-parallel training.
+ *
+ * Fits the solution x^2 - y^2 of the 2d Laplace problem on N points. Both
+ * modes process the same number of samples with Adam:
+ * - sync: every step computes a batch of workers * B points, split into one
+ *   shard per worker, and applies one update after the all-reduce;
+ * - hogwild: every worker applies its own update after each batch of B points.
+ *
+ * Usage: ./hogwild_benchmark [workers] [steps] [B]
+ */
+int main(int argc, char **argv) {
+    const size_t workers = argc > 1 ? std::strtoul(argv[1], nullptr, 10) : par::get_num_threads();
+    const size_t steps = argc > 2 ? std::strtoul(argv[2], nullptr, 10) : 300;
+    const size_t B = argc > 3 ? std::strtoul(argv[3], nullptr, 10) : 32;
+    const size_t N = 10000;
+    const T lr = 1e-3;
+
+    tensor::set_seed(1);
+    auto x = tensor::uniform<T>({N, 2}, -1.0, 1.0);
+    auto y = tensor::zeros<T>({N, 1});
+    for (size_t i = 0; i < N; ++i) y->data[i] = x->data[2 * i] * x->data[2 * i] - x->data[2 * i + 1] * x->data[2 * i + 1];
+
+    auto sample = [&](tensor::Philox &rng, size_t n) {
+        std::uniform_int_distribution<size_t> pick(0, N - 1);
+        std::vector<size_t> rows(n);
+        for (auto &r: rows) r = pick(rng);
+        return rows;
+    };
+    auto full_loss = [&](const tensor::nn::Model<T> &net) {
+        return mean(pow(net(x) - y, 2))->data[0];
+    };
+    auto factory = []() { return std::make_unique<tensor::nn::MLP<T>>(widths, 0.3); };
+
+    std::cout << "Threads: " << par::get_num_threads() << ", workers: " << workers
+              << ", batch: " << B << ", samples: " << workers * steps * B << "\n";
+    std::cout << std::setw(9) << "mode" << std::setw(10) << "seconds" << std::setw(14) << "samples/sec"
+              << std::setw(14) << "final loss" << std::setw(16) << "mean staleness" << std::setw(15) << "max staleness\n";
+
+    auto report = [&](const char *mode, double seconds, T loss, double mean_stale, size_t max_stale) {
+        std::cout << std::setw(9) << mode << std::setw(10) << std::fixed << std::setprecision(3) << seconds
+                  << std::setw(14) << std::setprecision(0) << workers * steps * B / seconds
+                  << std::setw(14) << std::scientific << std::setprecision(3) << loss
+                  << std::setw(16) << std::fixed << std::setprecision(2) << mean_stale
+                  << std::setw(14) << max_stale << "\n";
+        std::cout.unsetf(std::ios::floatfield);
+    };
+
+    {
+        tensor::set_seed(2);
+        tensor::nn::MLP<T> model(widths, 0.3);
+        tensor::optim::Adam<T> optim(model.getParams(), lr, 0.9, 0.999, 1e-8, 0.0);
+        par::DataParallel<T> dp(model, factory, workers);
+        tensor::Philox rng(3);
+
+        auto start = std::chrono::steady_clock::now();
+        for (size_t step = 0; step < steps; ++step) {
+            auto rows = sample(rng, workers * B);
+            optim.zero_grad();
+            dp.compute_gradients([&](const tensor::nn::Model<T> &net, size_t shard, size_t num_shards) {
+                auto [lo, hi] = par::shard_range(rows.size(), shard, num_shards);
+                std::vector<size_t> batch(rows.begin() + lo, rows.begin() + hi);
+                auto err = net(index_select(x, 0, batch)) - index_select(y, 0, batch);
+                return mean(pow(err, 2)) * (T(hi - lo) / rows.size());
+            });
+            optim.step();
+        }
+        double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+        report("sync", seconds, full_loss(model), 0, 0);
+    }
+
+    {
+        tensor::set_seed(2);
+        tensor::nn::MLP<T> model(widths, 0.3);
+        par::HogwildOptions<T> options;
+        options.num_workers = workers;
+        options.steps_per_worker = steps;
+        options.rule = par::HogwildRule::Adam;
+        options.lr = lr;
+        options.seed = 3;
+        par::Hogwild<T> hogwild(model, factory, options);
+
+        auto stats = hogwild.run([&](const tensor::nn::Model<T> &net, size_t, tensor::Philox &rng) {
+            auto batch = sample(rng, B);
+            return mean(pow(net(index_select(x, 0, batch)) - index_select(y, 0, batch), 2));
+        });
+        report("hogwild", stats.seconds, full_loss(model), stats.mean_staleness, stats.max_staleness);
+    }
+
+    return 0;
+}
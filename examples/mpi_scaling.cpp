@@ -0,0 +1,110 @@
+#include "tensor.hpp"
+#include <chrono>
+#include <cstdlib>
+#include <iomanip>
+#include <iostream>
+#include <thread>
+#include <vector>
+
+#ifdef USE_MPI
+
+using T = double;
+using namespace tensor::ops;
+namespace mpi = tensor::parallel::mpi;
+
+/**
+ * Strong-scaling benchmark of the MPI backend.
+ *
+ * Fits the solution of the 2d Laplace problem on N points with Adam, using
+ * communicators of 1, 2, 4, ... ranks taken from MPI_COMM_WORLD, and reports
+ * the epochs per second of each configuration.
+ *
+ * Every rank runs the tensor ops and BLAS on `threads` threads, by default the
+ * hardware threads of the node divided by the ranks running on it, so that
+ * ranks sharing a node do not oversubscribe its cores.
+ *
+ * Usage: mpirun -np 4 ./mpi_scaling [N] [epochs] [threads]
+ */
+int main(int argc, char **argv) {
+    mpi::Environment env(argc, argv);
+    const int world_rank = mpi::rank(), world_size = mpi::size();
+
+    const size_t N = argc > 1 ? std::strtoul(argv[1], nullptr, 10) : 20000;
+    const int epochs = argc > 2 ? std::atoi(argv[2]) : 20;
+    const size_t hidden = 32;
+
+    const size_t cores = std::max(1u, std::thread::hardware_concurrency());
+    const size_t threads = argc > 3 ? std::strtoul(argv[3], nullptr, 10)
+                                    : std::max<size_t>(1, cores / mpi::local_size());
+    tensor::parallel::set_num_threads(threads);
+
+    tensor::set_seed(1);
+    auto x = tensor::uniform<T>({N, 2}, -1.0, 1.0);
+    auto y = tensor::zeros<T>({N, 1});
+    for (size_t i = 0; i < N; ++i) y->data[i] = x->data[2 * i] * x->data[2 * i] - x->data[2 * i + 1] * x->data[2 * i + 1];
+
+    if (world_rank == 0) {
+        std::cout << "Points: " << N << ", epochs: " << epochs << ", threads per rank: "
+                  << tensor::parallel::get_num_threads() << "\n";
+        std::cout << std::setw(6) << "ranks" << std::setw(14) << "epochs/sec"
+                  << std::setw(10) << "speedup" << std::setw(12) << "efficiency" << std::setw(14) << "final loss" << "\n";
+    }
+
+    double base = 0;
+    for (int ranks = 1; ranks <= world_size; ranks *= 2) {
+        // Only the first `ranks` ranks take part in this configuration
+        MPI_Comm comm;
+        MPI_Comm_split(MPI_COMM_WORLD, world_rank < ranks ? 0 : MPI_UNDEFINED, world_rank, &comm);
+
+        if (comm != MPI_COMM_NULL) {
+            tensor::set_seed(2);
+            tensor::nn::MLP<T> net({2, hidden, hidden, 1}, 0.1);
+            mpi::broadcast_params(net.getParams(), 0, comm);
+            mpi::DistributedOptimizer<T> optim(net.getParams(), [](const std::vector<TensorS<T>> &params) {
+                return std::make_unique<tensor::optim::Adam<T>>(params, 1e-3, 0.9, 0.999, 1e-8, 0.0);
+            }, true, false, comm);
+
+            auto [lo, hi] = mpi::partition(N, comm);
+            std::vector<size_t> rows(hi - lo);
+            for (size_t i = 0; i < rows.size(); ++i) rows[i] = lo + i;
+            auto x_local = index_select(x, 0, rows);
+            auto y_local = index_select(y, 0, rows);
+
+            T loss = 0;
+            MPI_Barrier(comm);
+            auto start = std::chrono::steady_clock::now();
+            for (int epoch = 0; epoch < epochs; ++epoch) {
+                optim.zero_grad();
+                auto local_loss = mean(pow(net(x_local) - y_local, 2)) * (T(hi - lo) / N);
+                local_loss->backward();
+                optim.step();
+                loss = local_loss->data[0];
+            }
+            MPI_Allreduce(MPI_IN_PLACE, &loss, 1, MPI_DOUBLE, MPI_SUM, comm);
+            MPI_Barrier(comm);
+            double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+            if (world_rank == 0) {
+                double rate = epochs / seconds;
+                if (ranks == 1) base = rate;
+                std::cout << std::setw(6) << ranks << std::setw(14) << std::fixed << std::setprecision(2) << rate
+                          << std::setw(10) << rate / base << std::setw(12) << rate / base / ranks
+                          << std::setw(14) << std::scientific << std::setprecision(3) << loss << "\n";
+                std::cout.unsetf(std::ios::floatfield);
+            }
+            MPI_Comm_free(&comm);
+        }
+        MPI_Barrier(MPI_COMM_WORLD);
+    }
+
+    return 0;
+}
+
+#else
+
+int main() {
+    std::cout << "Build with -DUSE_MPI to run the MPI scaling benchmark\n";
+    return 0;
+}
+
+#endif
@@ -40,7 +40,7 @@ int main() {
     };
 
     auto loss_fn = [](auto pred, auto target) {
-        return mean(pow(pred + (-1.0f* target), 2));
+        return mean(pow(pred - target, 2));
     };
 
     // --- Training loop ---
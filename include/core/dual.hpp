@@ -0,0 +1,193 @@
+#ifndef DUAL_HPP
+#define DUAL_HPP
+
+#include <array>
+#include <cmath>
+#include <compare>
+#include <concepts>
+#include <numbers>
+#include <ostream>
+
+#include "defines.hpp"
+
+namespace tensor {
+
+    /**
+     * @brief Dual number with N tangent directions, for forward-mode differentiation.
+     *
+     * Represents x + sum_k eps_k e_k with e_j e_k = 0: arithmetic and the math
+     * functions below propagate the value together with the N directional
+     * derivatives, so evaluating f on a seeded input gives f and its Jacobian-vector
+     * products in a single pass.
+     *
+     * T may itself be a dual number: HyperDual<T> = Dual<Dual<T>> also carries
+     * second derivatives. Tensors and ops accept dual element types, so a model
+     * instantiated on Dual computes input derivatives alongside its forward pass.
+     *
+     * @tparam T Scalar type of the value and of the tangents
+     * @tparam N Number of tangent directions
+     */
+    template<typename T, size_t N = 1>
+    struct Dual {
+        T val{};
+        std::array<T, N> eps{};
+
+        constexpr Dual() = default;
+
+        /// Constant (all tangents zero), implicit so that literals mix with duals
+        template<typename S> requires std::convertible_to<S, T>
+        constexpr Dual(const S &v) : val(v) {}
+
+        constexpr Dual(const T &v, const std::array<T, N> &e) : val(v), eps(e) {}
+
+        /// Variable seeded along direction k
+        static constexpr Dual variable(const T &v, size_t k) {
+            Dual d(v);
+            d.eps[k] = T(1);
+            return d;
+        }
+
+        /// Explicit conversion to a plain scalar, dropping the tangents
+        template<std::floating_point S>
+        explicit constexpr operator S() const { return static_cast<S>(val); }
+
+        constexpr Dual &operator+=(const Dual &o) {
+            val += o.val;
+            for (size_t k = 0; k < N; ++k) eps[k] += o.eps[k];
+            return *this;
+        }
+
+        constexpr Dual &operator-=(const Dual &o) {
+            val -= o.val;
+            for (size_t k = 0; k < N; ++k) eps[k] -= o.eps[k];
+            return *this;
+        }
+
+        constexpr Dual &operator*=(const Dual &o) {
+            for (size_t k = 0; k < N; ++k) eps[k] = eps[k] * o.val + val * o.eps[k];
+            val *= o.val;
+            return *this;
+        }
+
+        constexpr Dual &operator/=(const Dual &o) {
+            const T inv = T(1) / o.val;
+            val *= inv;
+            for (size_t k = 0; k < N; ++k) eps[k] = (eps[k] - val * o.eps[k]) * inv;
+            return *this;
+        }
+
+        friend constexpr Dual operator+(Dual a, const Dual &b) { return a += b; }
+        friend constexpr Dual operator-(Dual a, const Dual &b) { return a -= b; }
+        friend constexpr Dual operator*(Dual a, const Dual &b) { return a *= b; }
+        friend constexpr Dual operator/(Dual a, const Dual &b) { return a /= b; }
+
+        friend constexpr Dual operator-(Dual a) {
+            a.val = -a.val;
+            for (auto &e: a.eps) e = -e;
+            return a;
+        }
+
+        friend constexpr Dual operator+(const Dual &a) { return a; }
+
+        /// Comparisons only look at the value
+        friend constexpr auto operator<=>(const Dual &a, const Dual &b) { return a.val <=> b.val; }
+        friend constexpr bool operator==(const Dual &a, const Dual &b) { return a.val == b.val; }
+
+        /**
+         * @brief Applies a scalar function with value f and derivative df at x.val.
+         */
+        static constexpr Dual chain(const Dual &x, const T &f, const T &df) {
+            Dual r(f);
+            for (size_t k = 0; k < N; ++k) r.eps[k] = df * x.eps[k];
+            return r;
+        }
+
+        friend Dual exp(const Dual &x) {
+            using std::exp;
+            T e = exp(x.val);
+            return chain(x, e, e);
+        }
+
+        friend Dual log(const Dual &x) {
+            using std::log;
+            return chain(x, log(x.val), T(1) / x.val);
+        }
+
+        friend Dual log1p(const Dual &x) {
+            using std::log1p;
+            return chain(x, log1p(x.val), T(1) / (T(1) + x.val));
+        }
+
+        friend Dual sqrt(const Dual &x) {
+            using std::sqrt;
+            T s = sqrt(x.val);
+            return chain(x, s, T(0.5) / s);
+        }
+
+        friend Dual sin(const Dual &x) {
+            using std::sin, std::cos;
+            return chain(x, sin(x.val), cos(x.val));
+        }
+
+        friend Dual cos(const Dual &x) {
+            using std::sin, std::cos;
+            return chain(x, cos(x.val), -sin(x.val));
+        }
+
+        friend Dual tanh(const Dual &x) {
+            using std::tanh;
+            T t = tanh(x.val);
+            return chain(x, t, T(1) - t * t);
+        }
+
+        friend Dual erf(const Dual &x) {
+            using std::erf, std::exp;
+            return chain(x, erf(x.val), T(std::numbers::inv_sqrtpi * 2) * exp(-x.val * x.val));
+        }
+
+        friend Dual abs(const Dual &x) {
+            return x.val < T(0) ? -x : x;
+        }
+
+        friend Dual pow(const Dual &x, int n) {
+            using std::pow;
+            if (n == 0) return Dual(T(1));
+            T p = pow(x.val, n - 1);
+            return chain(x, p * x.val, T(n) * p);
+        }
+
+        friend std::ostream &operator<<(std::ostream &os, const Dual &x) {
+            os << x.val << " [";
+            for (size_t k = 0; k < N; ++k) os << (k ? ", " : "") << x.eps[k];
+            return os << "]";
+        }
+    };
+
+    /// Dual number over dual numbers: carries first and second derivatives along one direction
+    template<typename T>
+    using HyperDual = Dual<Dual<T, 1>, 1>;
+
+    /**
+     * @brief Scalar math functions that accept both floating point and dual arguments.
+     *
+     * The kernels of the ops call these instead of the std functions, which are
+     * only overloaded for the built-in types; dual overloads are found by ADL.
+     */
+    namespace math {
+
+        template<typename T> T exp(const T &x) { using std::exp; return exp(x); }
+        template<typename T> T log(const T &x) { using std::log; return log(x); }
+        template<typename T> T log1p(const T &x) { using std::log1p; return log1p(x); }
+        template<typename T> T sqrt(const T &x) { using std::sqrt; return sqrt(x); }
+        template<typename T> T sin(const T &x) { using std::sin; return sin(x); }
+        template<typename T> T cos(const T &x) { using std::cos; return cos(x); }
+        template<typename T> T tanh(const T &x) { using std::tanh; return tanh(x); }
+        template<typename T> T erf(const T &x) { using std::erf; return erf(x); }
+        template<typename T> T abs(const T &x) { using std::abs; return abs(x); }
+        template<typename T> T pow(const T &x, int n) { using std::pow; return T(pow(x, n)); }
+
+    }
+
+}
+
+#endif
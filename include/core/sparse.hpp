@@ -0,0 +1,158 @@
+#ifndef SPARSE_HPP
+#define SPARSE_HPP
+
+#include <vector>
+#include <memory>
+#include <numeric>
+#include <stdexcept>
+
+#include "core/tensor_core.hpp"
+
+/**
+ * @brief Sparse matrix in compressed sparse row (CSR) format.
+ *
+ * The sparsity pattern (row_ptr, col_idx) is fixed at construction. The
+ * non-zero values are stored in a regular 1D tensor, so they can be
+ * constants (e.g. a stiffness matrix) or trainable parameters with
+ * requires_grad set, and can be used with every other tensor op.
+ *
+ * @tparam T the numeric type (e.g., float, double)
+ */
+template<Numeric T>
+struct SparseCSR {
+    /// Number of rows
+    size_t rows;
+
+    /// Number of columns
+    size_t cols;
+
+    /// Offsets of the first non-zero of every row (size rows + 1)
+    std::vector<size_t> row_ptr;
+
+    /// Column of every non-zero
+    std::vector<size_t> col_idx;
+
+    /// Non-zero values, 1D tensor of size nnz
+    TensorS<T> values;
+
+    /**
+     * @brief Constructs a CSR matrix.
+     *
+     * @param rows Number of rows
+     * @param cols Number of columns
+     * @param row_ptr Row offsets (size rows + 1)
+     * @param col_idx Column indices of the non-zeros
+     * @param values Values of the non-zeros
+     * @param requires_grad Whether gradients with respect to the values should be tracked
+     * @throws std::runtime_error if the arrays are not a valid CSR structure
+     */
+    SparseCSR(size_t rows, size_t cols, std::vector<size_t> row_ptr, std::vector<size_t> col_idx,
+              std::vector<T> values, bool requires_grad = false) :
+            rows(rows),
+            cols(cols),
+            row_ptr(std::move(row_ptr)),
+            col_idx(std::move(col_idx))
+    {
+        if (this->row_ptr.size() != rows + 1 || this->row_ptr.back() != this->col_idx.size()
+            || values.size() != this->col_idx.size())
+            throw std::runtime_error("Invalid CSR structure");
+        for (size_t r = 0; r < rows; ++r) {
+            if (this->row_ptr[r] > this->row_ptr[r + 1]) throw std::runtime_error("Invalid CSR structure");
+        }
+        for (auto c: this->col_idx) {
+            if (c >= cols) throw std::runtime_error("CSR column index out of range");
+        }
+        const size_t nnz = this->col_idx.size();
+        this->values = std::make_shared<Tensor<T>>(
+                typename Tensor<T>::Shape{nnz}, std::move(values), requires_grad);
+        build_transpose();
+    }
+
+    /**
+     * @return the number of stored non-zeros
+     */
+    size_t nnz() const {
+        return col_idx.size();
+    }
+
+    /// Pattern of the transpose matrix in CSR format, used by the backward passes
+    std::vector<size_t> t_row_ptr, t_col_idx;
+
+    /// Position in values of every non-zero of the transpose
+    std::vector<size_t> t_perm;
+
+private:
+    /**
+     * @brief Computes the CSR pattern of the transpose matrix.
+     */
+    void build_transpose() {
+        t_row_ptr.assign(cols + 1, 0);
+        for (auto c: col_idx) ++t_row_ptr[c + 1];
+        std::partial_sum(t_row_ptr.begin(), t_row_ptr.end(), t_row_ptr.begin());
+
+        t_col_idx.resize(nnz());
+        t_perm.resize(nnz());
+        std::vector<size_t> next(t_row_ptr.begin(), t_row_ptr.end() - 1);
+        for (size_t r = 0; r < rows; ++r) {
+            for (size_t k = row_ptr[r]; k < row_ptr[r + 1]; ++k) {
+                const size_t dst = next[col_idx[k]]++;
+                t_col_idx[dst] = r;
+                t_perm[dst] = k;
+            }
+        }
+    }
+};
+
+template<Numeric T> using SparseS = std::shared_ptr<SparseCSR<T>>;
+
+namespace tensor {
+
+    /**
+     * @brief Creates a CSR matrix from coordinate (COO) triplets.
+     *
+     * Entries are sorted by row and column; duplicated entries are summed.
+     *
+     * @tparam T Numeric type
+     * @param rows Number of rows
+     * @param cols Number of columns
+     * @param row Row index of every entry
+     * @param col Column index of every entry
+     * @param val Value of every entry
+     * @param requires_grad Whether gradients with respect to the values should be tracked
+     * @return Shared pointer to the new sparse matrix
+     */
+    template<Numeric T>
+    inline SparseS<T> sparse_from_coo(size_t rows, size_t cols, const std::vector<size_t> &row,
+                                      const std::vector<size_t> &col, const std::vector<T> &val,
+                                      bool requires_grad = false)
+    {
+        if (row.size() != col.size() || row.size() != val.size())
+            throw std::runtime_error("COO arrays must have the same size");
+
+        std::vector<size_t> order(row.size());
+        std::iota(order.begin(), order.end(), 0);
+        std::stable_sort(order.begin(), order.end(), [&](size_t a, size_t b) {
+            return row[a] != row[b] ? row[a] < row[b] : col[a] < col[b];
+        });
+
+        std::vector<size_t> row_ptr(rows + 1, 0), col_idx;
+        std::vector<T> values;
+        for (size_t k = 0; k < order.size(); ++k) {
+            const size_t e = order[k];
+            if (row[e] >= rows) throw std::runtime_error("COO row index out of range");
+            if (k > 0 && row[e] == row[order[k - 1]] && col[e] == col[order[k - 1]]) {
+                values.back() += val[e];
+                continue;
+            }
+            col_idx.push_back(col[e]);
+            values.push_back(val[e]);
+            ++row_ptr[row[e] + 1];
+        }
+        std::partial_sum(row_ptr.begin(), row_ptr.end(), row_ptr.begin());
+
+        return std::make_shared<SparseCSR<T>>(rows, cols, row_ptr, col_idx, values, requires_grad);
+    }
+
+}
+
+#endif
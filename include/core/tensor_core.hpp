@@ -8,14 +8,18 @@
 #endif
 
 #include <unordered_set>
+#include <unordered_map>
 #include <vector>
 #include <memory>
 #include <algorithm>
+#include <stdexcept>
 #include <functional>
 #include <cmath>
 #include <string>
 
 #include "defines.hpp"
+#include "core/dual.hpp"
+#include "parallel/thread_pool.hpp"
 
 template<Numeric T> struct Tensor;
 template<Numeric T> using TensorS = std::shared_ptr<Tensor<T>>;
@@ -106,43 +110,122 @@ struct Tensor : public std::enable_shared_from_this<Tensor<T>> {
      * 
      * @param clean_graph if true it cleans the tensor's parents vector and 
      *                    gradient function to free memory
+     * @param parallel if true independent branches of the graph are executed
+     *                 concurrently on the thread pool (see run_parallel). In
+     *                 deterministic mode the result only depends on the graph, also
+     *                 when the backward cannot run concurrently (a single thread, or
+     *                 a call from a task of the pool)
      */
-    void backward(bool clean_graph = true)
+    void backward(bool clean_graph = true, bool parallel = false)
     {
-        std::vector<TensorS<T>> graph;
-        std::unordered_set<Tensor<T>*> visited;
-
-        std::function<void(TensorS<T>)> build_graph = [&](TensorS<T> v) {
-            if (visited.find(v.get()) == visited.end()) {
-                visited.insert(v.get());
-                for (auto &p: v->prev) build_graph(p);
-                graph.push_back(v);
-            }
-        };
+        backward(std::vector<T>(data.size(), T(1)), std::vector<T>(data.size(), T(0)), clean_graph, parallel);
+    }
 
-        build_graph(this->shared_from_this());
+    /**
+     * @brief Performs backpropagation from a custom seed (vector-Jacobian product).
+     *
+     * The gradient of this tensor is set to seed_grad and its Hessian to
+     * seed_hess before the reverse sweep, so the leaves receive
+     * sum_k seed_grad[k] du_k/dx. With a one-hot seed per output column this
+     * differentiates a single output of a multi-output model.
+     *
+     * @param seed_grad Seed of the gradient, one value per element
+     * @param seed_hess Seed of the Hessian channel (zeros if empty)
+     * @param clean_graph if true the graph is released after the sweep
+     * @param parallel if true independent branches run concurrently
+     * @throws std::runtime_error if a seed does not match the size of the tensor
+     */
+    void backward(const std::vector<T> &seed_grad, const std::vector<T> &seed_hess, bool clean_graph = true,
+                  bool parallel = false)
+    {
+        check_seed(seed_grad, seed_hess);
+        auto graph = topological_order();
 
         if (this->requires_grad) {
-            std::fill(this->grad.begin(), this->grad.end(), T(1));
-            std::fill(this->hess.begin(), this->hess.end(), T(0));
+            this->grad = seed_grad;
+            if (seed_hess.empty()) std::fill(this->hess.begin(), this->hess.end(), T(0));
+            else this->hess = seed_hess;
         }
 
         #if TENSOR_DEBUG
         print_graph(graph);
         #endif
 
-        for (auto it = graph.rbegin(); it != graph.rend(); ++it) {
-            (*it)->grad_fn();
+        if (parallel && tensor::parallel::get_num_threads() > 1
+            && !tensor::parallel::ThreadPool::in_parallel_region()) {
+            run_parallel(graph);
+        } else if (parallel && tensor::parallel::deterministic()) {
+            // Same accumulation as run_parallel, so the result does not depend on the thread count
+            Dependencies deps(graph);
+            for (size_t i = graph.size(); i-- > 0;) run_node(graph, deps, i);
+        } else {
+            for (auto it = graph.rbegin(); it != graph.rend(); ++it) {
+                (*it)->grad_fn();
+            }
         }
 
-        // Breaks links to parent nodes and clears grad_fn, freeing temporary nodes after backward.
-        if (clean_graph) {
-            for (auto &node: graph) {
-                node->prev.clear();
-                node->grad_fn = []() {};
+        if (clean_graph) release(graph);
+    }
+
+    /**
+     * @brief Gradient and diagonal Hessian of a tensor for one seed channel.
+     */
+    struct Derivatives {
+        std::vector<T> grad, hess;
+    };
+
+    /**
+     * @brief Backpropagates several seeds in a single traversal of the graph.
+     *
+     * The C seed channels are stacked in the gradient and Hessian buffers of every
+     * node (see channels), and the gradient function of every node runs once for
+     * all of them: a matmul propagates the C channels of its output as one GEMM
+     * over C times the rows, and the element-wise kernels compute their
+     * derivatives once per element. The per-output derivatives of a K-output model
+     * cost one forward pass and a single backward sweep over K-wide buffers.
+     *
+     * The grad and hess of the nodes are left unchanged.
+     *
+     * @param seed_grads Gradient seed of every channel, one value per element
+     * @param inputs Tensors whose derivatives are returned
+     * @param seed_hess Hessian seed of every channel (zeros if empty)
+     * @param clean_graph if true the graph is released after the traversal
+     * @return result[c][i]: derivatives of inputs[i] for channel c (zeros if it does not require grad)
+     * @throws std::runtime_error if a seed does not match the size of the tensor
+     */
+    std::vector<std::vector<Derivatives>> backward_channels(const std::vector<std::vector<T>> &seed_grads,
+                                                            const std::vector<TensorS<T>> &inputs,
+                                                            const std::vector<std::vector<T>> &seed_hess = {},
+                                                            bool clean_graph = true)
+    {
+        const size_t C = seed_grads.size();
+        if (!seed_hess.empty() && seed_hess.size() != C)
+            throw std::runtime_error("backward_channels: one Hessian seed per channel is required");
+        for (size_t c = 0; c < C; ++c) check_seed(seed_grads[c], seed_hess.empty() ? std::vector<T>{} : seed_hess[c]);
+
+        auto graph = topological_order();
+        auto index = node_index(graph);
+
+        // buffers[i] holds the derivatives of node i for all the channels, stacked
+        std::vector<Derivatives> buffers(graph.size());
+        if (this->requires_grad) {
+            auto &root = buffers[index.at(this)];
+            root.grad.assign(C * data.size(), T(0));
+            root.hess.assign(C * data.size(), T(0));
+            for (size_t c = 0; c < C; ++c) {
+                std::copy(seed_grads[c].begin(), seed_grads[c].end(), root.grad.begin() + c * data.size());
+                if (!seed_hess.empty())
+                    std::copy(seed_hess[c].begin(), seed_hess[c].end(), root.hess.begin() + c * data.size());
             }
         }
 
+        auto result = zero_slices(inputs, C);
+        run_channels(graph, index, buffers, C, [&](size_t i, Derivatives &derivatives) {
+            store_slices(graph[i].get(), derivatives, inputs, result);
+        });
+
+        if (clean_graph) release(graph);
+        return result;
     }
 
     /**
@@ -154,6 +237,41 @@ struct Tensor : public std::enable_shared_from_this<Tensor<T>> {
         std::fill(this->hess.begin(), this->hess.end(), T(0));
     }
 
+    /**
+     * @brief Buffer the gradient functions of the consumers of this tensor accumulate its gradient into.
+     *
+     * This is grad, unless the calling thread is running a consumer that run_parallel
+     * gave its own partial buffer. Gradient functions fetch it once, before spreading
+     * their loops over threads.
+     */
+    std::vector<T> &grad_sink()
+    {
+        if (Partial *partial = find_partial()) return partial->grad;
+        return grad;
+    }
+
+    /**
+     * @brief Buffer the Hessian is accumulated into (see grad_sink).
+     */
+    std::vector<T> &hess_sink()
+    {
+        if (Partial *partial = find_partial()) return partial->hess;
+        return hess;
+    }
+
+    /**
+     * @brief Number of seed channels stacked in grad and hess.
+     *
+     * grad and hess hold one block of data.size() values per channel, channel
+     * after channel: 1 in backward, C while backward_channels or backward_roots
+     * run the gradient function of the node. The gradient functions loop over
+     * the channels, so they run once per node whatever the number of channels.
+     */
+    size_t channels() const
+    {
+        return grad.size() / data.size();
+    }
+
     /**
      * @brief Permutes the rows of a 2D tensor.
      * 
@@ -208,6 +326,441 @@ struct Tensor : public std::enable_shared_from_this<Tensor<T>> {
         }
     }
 
+    /**
+     * @brief Backpropagates several roots (e.g. the terms of a loss) through one traversal of their shared graph.
+     *
+     * The union of the graphs of the roots is traversed once with one stacked
+     * seed channel per root (see backward_channels): root r is seeded with ones in
+     * channel r, and every node, shared by several roots or not, runs its gradient
+     * function once for all the channels. Every root gets its own gradient slice:
+     * result[r][i] holds the derivatives of roots[r] with respect to inputs[i].
+     *
+     * Only the slices of the inputs are kept; the stacked buffers of the other
+     * nodes are freed as soon as their gradient function has run.
+     *
+     * @param roots Tensors to differentiate
+     * @param inputs Tensors whose derivatives are returned
+     * @param accumulate if true the sum over the roots is also added to the grad and
+     *                   hess of the inputs, as a backward of the total would do
+     * @param clean_graph if true the graph is released after the traversal
+     */
+    static std::vector<std::vector<Derivatives>> backward_roots(const std::vector<TensorS<T>> &roots,
+                                                                const std::vector<TensorS<T>> &inputs,
+                                                                bool accumulate = true, bool clean_graph = true)
+    {
+        auto graph = topological_order(roots);
+        auto index = node_index(graph);
+        auto buffers = root_buffers(roots, graph, index);
+
+        auto result = zero_slices(inputs, roots.size());
+        run_channels(graph, index, buffers, roots.size(), [&](size_t i, Derivatives &derivatives) {
+            if (accumulate) accumulate_channels(*graph[i], derivatives, inputs);
+            store_slices(graph[i].get(), derivatives, inputs, result);
+        });
+
+        if (clean_graph) release(graph);
+        return result;
+    }
+
+    /**
+     * @brief Euclidean norm of the gradient of every root with respect to the inputs.
+     *
+     * Same traversal as backward_roots, but only the norms are returned:
+     * norms[r] = ||d roots[r] / d inputs|| over all the inputs, e.g. to balance the
+     * terms of a loss. The squared norm of every channel is accumulated when the
+     * sweep completes an input, so no gradient slice is kept.
+     *
+     * @param roots Tensors to differentiate
+     * @param inputs Tensors with respect to which the norms are computed
+     * @param accumulate if true the sum over the roots is added to the grad and hess of the inputs
+     * @param clean_graph if true the graph is released after the traversal
+     */
+    static std::vector<T> gradient_norms(const std::vector<TensorS<T>> &roots, const std::vector<TensorS<T>> &inputs,
+                                         bool accumulate = true, bool clean_graph = true)
+    {
+        auto graph = topological_order(roots);
+        auto index = node_index(graph);
+        auto buffers = root_buffers(roots, graph, index);
+
+        std::vector<T> norms(roots.size(), T(0));
+        run_channels(graph, index, buffers, roots.size(), [&](size_t i, Derivatives &derivatives) {
+            if (accumulate) accumulate_channels(*graph[i], derivatives, inputs);
+            const auto count = std::count_if(inputs.begin(), inputs.end(),
+                                             [&](const TensorS<T> &input) { return input == graph[i]; });
+            const size_t n = graph[i]->data.size();
+            for (size_t r = 0; r < roots.size(); ++r) {
+                for (size_t j = r * n; j < (r + 1) * n; ++j) norms[r] += T(count) * derivatives.grad[j] * derivatives.grad[j];
+            }
+        });
+
+        for (auto &norm: norms) norm = tensor::math::sqrt(norm);
+        if (clean_graph) release(graph);
+        return norms;
+    }
+
+private:
+
+    /**
+     * @return result[c][i]: zero derivatives of inputs[i] for every channel c
+     */
+    static std::vector<std::vector<Derivatives>> zero_slices(const std::vector<TensorS<T>> &inputs, size_t channels)
+    {
+        std::vector<std::vector<Derivatives>> result(channels);
+        for (auto &slices: result) {
+            for (auto &input: inputs) {
+                slices.push_back({std::vector<T>(input->data.size(), T(0)),
+                                  std::vector<T>(input->data.size(), T(0))});
+            }
+        }
+        return result;
+    }
+
+    /**
+     * @brief Copies the complete derivatives of a node, channel by channel, into the slices of the inputs it appears as.
+     */
+    static void store_slices(const Tensor<T> *node, const Derivatives &derivatives,
+                             const std::vector<TensorS<T>> &inputs, std::vector<std::vector<Derivatives>> &result)
+    {
+        const size_t n = node->data.size();
+        for (size_t i = 0; i < inputs.size(); ++i) {
+            if (inputs[i].get() != node) continue;
+            for (size_t c = 0; c < result.size(); ++c) {
+                result[c][i].grad.assign(derivatives.grad.begin() + c * n, derivatives.grad.begin() + (c + 1) * n);
+                result[c][i].hess.assign(derivatives.hess.begin() + c * n, derivatives.hess.begin() + (c + 1) * n);
+            }
+        }
+    }
+
+    /**
+     * @brief Adds the derivatives of every channel to the grad and hess of a node, once per input it appears as.
+     */
+    static void accumulate_channels(Tensor<T> &node, const Derivatives &derivatives,
+                                    const std::vector<TensorS<T>> &inputs)
+    {
+        const size_t n = node.data.size();
+        for (auto &input: inputs) {
+            if (input.get() != &node) continue;
+            for (size_t k = 0; k < derivatives.grad.size(); k += n) {
+                for (size_t j = 0; j < n; ++j) {
+                    node.grad[j] += derivatives.grad[k + j];
+                    node.hess[j] += derivatives.hess[k + j];
+                }
+            }
+        }
+    }
+
+    /**
+     * @brief Stacked channel buffers of a graph with root r seeded with ones in channel r.
+     */
+    static std::vector<Derivatives> root_buffers(const std::vector<TensorS<T>> &roots,
+                                                 const std::vector<TensorS<T>> &graph,
+                                                 const std::unordered_map<Tensor<T>*, size_t> &index)
+    {
+        std::vector<Derivatives> buffers(graph.size());
+        for (size_t r = 0; r < roots.size(); ++r) {
+            if (!roots[r]->requires_grad) continue;
+            const size_t n = roots[r]->data.size();
+            auto &root = buffers[index.at(roots[r].get())];
+            if (root.grad.empty()) {
+                root.grad.assign(roots.size() * n, T(0));
+                root.hess.assign(roots.size() * n, T(0));
+            }
+            std::fill(root.grad.begin() + r * n, root.grad.begin() + (r + 1) * n, T(1));
+        }
+        return buffers;
+    }
+
+    /**
+     * @return the nodes of the graph ending in this tensor, in topological order
+     */
+    std::vector<TensorS<T>> topological_order()
+    {
+        return topological_order({this->shared_from_this()});
+    }
+
+    /**
+     * @return the nodes of the union of the graphs ending in the roots, in topological order
+     */
+    static std::vector<TensorS<T>> topological_order(const std::vector<TensorS<T>> &roots)
+    {
+        std::vector<TensorS<T>> graph;
+        std::unordered_set<Tensor<T>*> visited;
+
+        std::function<void(TensorS<T>)> build_graph = [&](TensorS<T> v) {
+            if (visited.find(v.get()) == visited.end()) {
+                visited.insert(v.get());
+                for (auto &p: v->prev) build_graph(p);
+                graph.push_back(v);
+            }
+        };
+
+        for (auto &root: roots) build_graph(root);
+        return graph;
+    }
+
+    /**
+     * @brief Runs the gradient function of every node once for all the stacked channels.
+     *
+     * When a node is visited its stacked buffers are complete: they are swapped into
+     * its grad and hess, together with the stacked buffers of its parents (allocated
+     * when a consumer first writes them), and its gradient function runs once. Then
+     * on_complete(i, buffers[i]) is called and the buffers are freed, so only the
+     * nodes on the frontier of the sweep hold buffers.
+     *
+     * @param graph Nodes in topological order
+     * @param index Position of every node in graph
+     * @param buffers buffers[i]: derivatives of node i for all channels, seeded by the caller
+     * @param channels Number of channels
+     * @param on_complete Called with the complete derivatives of every reached node that requires grad
+     */
+    template <typename OnComplete>
+    static void run_channels(const std::vector<TensorS<T>> &graph,
+                             const std::unordered_map<Tensor<T>*, size_t> &index,
+                             std::vector<Derivatives> &buffers, size_t channels, OnComplete &&on_complete)
+    {
+        for (size_t i = graph.size(); i-- > 0;) {
+            const auto &node = graph[i];
+            auto &own = buffers[i];
+            if (node->requires_grad && !own.grad.empty()) {
+                // The node and its distinct parents are the only buffers its gradient function touches
+                std::vector<size_t> parents;
+                for (auto &p: node->prev) {
+                    size_t j = index.at(p.get());
+                    if (p->requires_grad && std::find(parents.begin(), parents.end(), j) == parents.end())
+                        parents.push_back(j);
+                }
+                for (auto j: parents) {
+                    auto &d = buffers[j];
+                    if (d.grad.empty()) {
+                        d.grad.assign(channels * graph[j]->data.size(), T(0));
+                        d.hess.assign(channels * graph[j]->data.size(), T(0));
+                    }
+                }
+
+                auto swap_in = [&]() {
+                    std::swap(node->grad, own.grad);
+                    std::swap(node->hess, own.hess);
+                    for (auto j: parents) {
+                        std::swap(graph[j]->grad, buffers[j].grad);
+                        std::swap(graph[j]->hess, buffers[j].hess);
+                    }
+                };
+                swap_in();
+                node->grad_fn();
+                swap_in();
+                on_complete(i, own);
+            }
+            own = Derivatives{};
+        }
+    }
+
+    static std::unordered_map<Tensor<T>*, size_t> node_index(const std::vector<TensorS<T>> &graph)
+    {
+        std::unordered_map<Tensor<T>*, size_t> index;
+        for (size_t i = 0; i < graph.size(); ++i) index[graph[i].get()] = i;
+        return index;
+    }
+
+    /**
+     * @brief Breaks links to parent nodes and clears grad_fn, freeing temporary nodes after backward.
+     *
+     * Leaves are left untouched, so leaves shared by graphs differentiated on other threads
+     * (e.g. a dataset tensor) are never written.
+     */
+    static void release(const std::vector<TensorS<T>> &graph)
+    {
+        for (auto &node: graph) {
+            if (node->prev.empty()) continue;
+            node->prev.clear();
+            node->grad_fn = []() {};
+        }
+    }
+
+    /// Gradient and Hessian of a shared parent accumulated by one of its consumers
+    struct Partial {
+        const Tensor<T> *target;
+        std::vector<T> grad, hess;
+    };
+
+    /// Partials of the gradient function running on this thread, if any
+    static inline thread_local std::vector<Partial> *partials = nullptr;
+
+    Partial *find_partial() const
+    {
+        if (!partials) return nullptr;
+        for (auto &partial: *partials) {
+            if (partial.target == this) return &partial;
+        }
+        return nullptr;
+    }
+
+    void check_seed(const std::vector<T> &seed_grad, const std::vector<T> &seed_hess) const
+    {
+        if (seed_grad.size() != data.size() || (!seed_hess.empty() && seed_hess.size() != data.size()))
+            throw std::runtime_error("backward seed does not match the size of the tensor");
+    }
+
+    /**
+     * @brief Parents and consumers of the nodes of a graph, and the partials of the shared parents.
+     */
+    struct Dependencies {
+        /// Distinct parents of every node and consumers of every node, in graph order
+        std::vector<std::vector<size_t>> parents, consumers;
+
+        /// Whether a node is written by its consumers through partials
+        std::vector<bool> shared;
+
+        /// Partials of the shared parents of every node
+        std::vector<std::vector<Partial>> partials;
+
+        explicit Dependencies(const std::vector<TensorS<T>> &graph)
+                : parents(graph.size()), consumers(graph.size()), shared(graph.size()), partials(graph.size())
+        {
+            auto index = node_index(graph);
+            for (size_t i = 0; i < graph.size(); ++i) {
+                for (auto &p: graph[i]->prev) parents[i].push_back(index[p.get()]);
+                std::sort(parents[i].begin(), parents[i].end());
+                parents[i].erase(std::unique(parents[i].begin(), parents[i].end()), parents[i].end());
+                for (auto p: parents[i]) consumers[p].push_back(i);
+            }
+            for (size_t p = 0; p < graph.size(); ++p)
+                shared[p] = consumers[p].size() > 1 && graph[p]->requires_grad;
+        }
+    };
+
+    /**
+     * @brief Runs the gradient function of node i once all of its consumers have run.
+     *
+     * The partials of the consumers are first added to the node if it is shared, and
+     * the node writes its shared parents through partials (see run_parallel).
+     */
+    static void run_node(const std::vector<TensorS<T>> &graph, Dependencies &deps, size_t i)
+    {
+        if (deps.shared[i]) gather_partials(*graph[i], deps.consumers[i], deps.partials);
+        for (auto p: deps.parents[i]) {
+            if (deps.shared[p] && deps.consumers[p].back() != i) {
+                const size_t size = graph[p]->data.size();
+                deps.partials[i].push_back({graph[p].get(), std::vector<T>(size, T(0)),
+                                            std::vector<T>(size, T(0))});
+            }
+        }
+        partials = &deps.partials[i];
+        try {
+            graph[i]->grad_fn();
+        } catch (...) {
+            partials = nullptr;
+            throw;
+        }
+        partials = nullptr;
+    }
+
+    /**
+     * @brief Executes the gradient functions of a graph with a dependency-counting scheduler.
+     *
+     * A node becomes ready once all of its consumers have run, and ready nodes are
+     * executed concurrently on the thread pool. Gradient functions accumulate into
+     * their parents, so a parent shared by several consumers (e.g. a parameter used
+     * by two branches of the loss) would be written by concurrent nodes: the first
+     * of its consumers in the serial backward order accumulates into it directly,
+     * every other one into its own zeroed partial buffers (see grad_sink). When the
+     * parent becomes ready the partials are added to it in a fixed order, so the
+     * result only depends on the graph, not on the scheduling nor on the number of
+     * threads. It may differ in the last bits from the serial backward, which
+     * accumulates every consumer into the parent directly.
+     *
+     * When a single node is ready and nothing else is running, it is executed on
+     * the calling thread so that its op can still use intra-op parallelism.
+     * BLAS runs single-threaded during the traversal, since several nodes may
+     * issue BLAS calls at once.
+     *
+     * @param graph Nodes in topological order
+     */
+    static void run_parallel(const std::vector<TensorS<T>> &graph)
+    {
+        const size_t n = graph.size();
+        Dependencies deps(graph);
+
+        // Number of consumers each node waits for
+        std::vector<size_t> pending(n);
+        for (size_t p = 0; p < n; ++p) pending[p] = deps.consumers[p].size();
+
+        auto &pool = tensor::parallel::pool();
+        tensor::parallel::BlasThreadsGuard blas_guard(1);
+
+        std::mutex state_mutex;
+        std::vector<size_t> ready{n - 1};
+        size_t running = 0, done = 0;
+        std::exception_ptr error;
+
+        std::function<void(size_t)> execute = [&](size_t i) {
+            try {
+                run_node(graph, deps, i);
+            } catch (...) {
+                std::lock_guard<std::mutex> lock(state_mutex);
+                if (!error) error = std::current_exception();
+            }
+
+            // Releases the parents and dispatches the nodes that became ready
+            std::vector<size_t> next;
+            {
+                std::lock_guard<std::mutex> lock(state_mutex);
+                --running;
+                ++done;
+                for (auto p: deps.parents[i]) {
+                    if (--pending[p] == 0) next.push_back(p);
+                }
+                if (running == 0 && next.size() == 1) {
+                    ready.push_back(next[0]);
+                    return;
+                }
+                running += next.size();
+            }
+            for (auto p: next) pool.submit([&execute, p]() { execute(p); });
+        };
+
+        while (true) {
+            size_t i;
+            pool.wait_until([&]() {
+                std::lock_guard<std::mutex> lock(state_mutex);
+                return done == n || !ready.empty();
+            });
+            {
+                std::lock_guard<std::mutex> lock(state_mutex);
+                if (ready.empty()) break;
+                i = ready.back();
+                ready.pop_back();
+                ++running;
+            }
+            execute(i);
+        }
+
+        if (error) std::rethrow_exception(error);
+    }
+
+    /**
+     * @brief Adds the partials of the consumers of a shared node to its gradient and Hessian.
+     *
+     * The last consumer in graph order has accumulated into the node directly; the
+     * partials of the others are added in reverse graph order, and released.
+     */
+    static void gather_partials(Tensor<T> &node, const std::vector<size_t> &consumers,
+                                std::vector<std::vector<Partial>> &node_partials)
+    {
+        for (size_t k = consumers.size() - 1; k-- > 0;) {
+            auto &list = node_partials[consumers[k]];
+            auto partial = std::find_if(list.begin(), list.end(),
+                                        [&](const Partial &q) { return q.target == &node; });
+            tensor::parallel::parallel_for(0, node.grad.size(), [&](size_t lo, size_t hi) {
+                for (size_t j = lo; j < hi; ++j) {
+                    node.grad[j] += partial->grad[j];
+                    node.hess[j] += partial->hess[j];
+                }
+            });
+            partial->grad = {};
+            partial->hess = {};
+        }
+    }
+
 };
 
-#endif
\ No newline at end of file
+#endif
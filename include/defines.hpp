@@ -2,8 +2,22 @@
 #define DEFINES_HPP
 
 #include <concepts>
+#include <cstddef>
+#include <type_traits>
+
+namespace tensor {
+    template<typename T, std::size_t N>
+    struct Dual;
+}
+
+/// Whether T is a forward-mode dual number (see core/dual.hpp)
+template <typename T>
+struct is_dual : std::false_type {};
+
+template <typename T, std::size_t N>
+struct is_dual<tensor::Dual<T, N>> : std::true_type {};
 
 template <typename T>
-concept Numeric = std::floating_point<T>;
+concept Numeric = std::floating_point<T> || is_dual<T>::value;
 
-#endif // DEFINES_HPP
\ No newline at end of file
+#endif // DEFINES_HPP
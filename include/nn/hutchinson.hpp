@@ -0,0 +1,78 @@
+#ifndef HUTCHINSON_HPP
+#define HUTCHINSON_HPP
+
+#include <stdexcept>
+#include <vector>
+
+#include "core/tensor_core.hpp"
+#include "nn/model.hpp"
+#include "ops/arithmetic.hpp"
+#include "ops/indexing.hpp"
+#include "utils/random.hpp"
+#include "utils/tensor_utils.hpp"
+
+namespace tensor::nn {
+
+    /**
+     * @brief Rademacher probes: a tensor of the given shape with independent entries of +1 or -1.
+     */
+    template<Numeric T>
+    TensorS<T> rademacher(const typename Tensor<T>::Shape &shape, Philox &rng = global_rng()) {
+        auto v = tensor::zeros<T>(shape);
+        uint32_t bits = 0;
+        for (size_t i = 0; i < v->data.size(); ++i) {
+            if (i % 32 == 0) bits = rng();
+            v->data[i] = (bits >> (i % 32)) & 1u ? T(1) : T(-1);
+        }
+        return v;
+    }
+
+    /**
+     * @brief Stochastic estimate of the input Laplacian (Hutchinson trace estimator).
+     *
+     *     lap u(x) = tr H(x) = E[v^T H(x) v],    v_k = +1 or -1 with equal probability
+     *
+     * Every probe term v^T H v is the second derivative of u(x + t v) at t = 0,
+     * computed by an order-2 Taylor-mode pass, so the cost per point depends on
+     * the number of probes and not on the input dimension. The probes of all
+     * points are stacked into a single pass.
+     *
+     * The estimate is unbiased, with variance 2 sum_{i != j} H_ij^2 / probes,
+     * and is a graph node, so it can replace the exact Laplacian of a PDE
+     * residual in high dimensions.
+     *
+     * @param model Model implementing the Taylor-mode pass
+     * @param x Input points of shape (N, d)
+     * @param probes Number of probes per point
+     * @param rng Generator of the probes
+     * @return Laplacian estimate of shape (N, K)
+     * @throws std::runtime_error if probes is zero or x is not 2D
+     */
+    template<Numeric T>
+    TensorS<T> hutchinson_laplacian(const Model<T> &model, const TensorS<T> &x, size_t probes,
+                                    Philox &rng = global_rng()) {
+        using namespace tensor::ops;
+        if (probes == 0) throw std::runtime_error("hutchinson_laplacian requires at least one probe");
+        if (x->shape.size() != 2) throw std::runtime_error("hutchinson_laplacian expects an input of shape (N, d)");
+        const size_t N = x->shape[0], d = x->shape[1];
+
+        // Probe s of point n is row s * N + n
+        auto xs = concat(std::vector<TensorS<T>>(probes, x), 0);
+        auto v = rademacher<T>({probes * N, d}, rng);
+
+        // Second Taylor coefficient: v^T H v / 2
+        auto c2 = forward_taylor(model, xs, v, 2).c[2];
+
+        TensorS<T> total;
+        std::vector<size_t> rows(N);
+        for (size_t s = 0; s < probes; ++s) {
+            for (size_t n = 0; n < N; ++n) rows[n] = s * N + n;
+            auto block = index_select(c2, 0, rows);
+            total = total ? total + block : block;
+        }
+        return total * (T(2) / T(probes));
+    }
+
+}
+
+#endif
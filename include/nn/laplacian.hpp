@@ -0,0 +1,118 @@
+#ifndef LAPLACIAN_HPP
+#define LAPLACIAN_HPP
+
+#include <numbers>
+#include <stdexcept>
+
+#include "core/tensor_core.hpp"
+#include "ops/activations.hpp"
+#include "ops/arithmetic.hpp"
+#include "ops/matmul.hpp"
+#include "ops/reductions.hpp"
+#include "utils/tensor_utils.hpp"
+
+namespace tensor::nn {
+
+    /**
+     * @brief Value, Jacobian and Laplacian of a network with respect to its input.
+     *
+     * For an input x of shape (N, d) and an activation u(x) of shape (N, K):
+     * - u has shape (N, K);
+     * - J has shape (d, N, K), J[k] = du/dx_k;
+     * - L has shape (N, K), L = sum_k d^2u/dx_k^2.
+     *
+     * All three are ordinary graph nodes, so any loss built from them is
+     * differentiable with respect to the parameters of the network.
+     */
+    template<Numeric T>
+    struct LaplacianState {
+        TensorS<T> u, J, L;
+    };
+
+    /**
+     * @brief Pushes a forward-Laplacian state through an element-wise function.
+     *
+     * With y = f(u), by the chain rule
+     *
+     *     J' = f'(u) J_k
+     *     L' = f'(u) L + f''(u) sum_k J_k^2
+     *
+     * @param s Input state
+     * @param y f(u)
+     * @param dy f'(u), as a graph node
+     * @param d2y f''(u), as a graph node
+     */
+    template<Numeric T>
+    LaplacianState<T> elementwise(const LaplacianState<T> &s, TensorS<T> y, TensorS<T> dy, TensorS<T> d2y) {
+        using namespace tensor::ops;
+        return {y, s.J * dy, s.L * dy + d2y * sum(pow(s.J, 2), 0)};
+    }
+
+    /**
+     * @brief tanh of a forward-Laplacian state: f' = 1 - t^2, f'' = -2 t f'.
+     */
+    template<Numeric T>
+    LaplacianState<T> tanh(const LaplacianState<T> &s) {
+        using namespace tensor::ops;
+        auto t = tensor::ops::tanh(s.u);
+        auto dy = T(1) - pow(t, 2);
+        return elementwise(s, t, dy, T(-2) * (t * dy));
+    }
+
+    /**
+     * @brief sin of a forward-Laplacian state: f' = cos(u) = sin(u + pi/2), f'' = -sin(u).
+     */
+    template<Numeric T>
+    LaplacianState<T> sin(const LaplacianState<T> &s) {
+        using namespace tensor::ops;
+        auto y = tensor::ops::sin(s.u);
+        return elementwise(s, y, tensor::ops::sin(s.u + T(std::numbers::pi / 2)), -y);
+    }
+
+    /**
+     * @brief sigmoid of a forward-Laplacian state: f' = s (1 - s), f'' = f' (1 - 2 s).
+     */
+    template<Numeric T>
+    LaplacianState<T> sigmoid(const LaplacianState<T> &s) {
+        using namespace tensor::ops;
+        auto y = tensor::ops::sigmoid(s.u);
+        auto dy = y * (T(1) - y);
+        return elementwise(s, y, dy, dy * (T(1) - T(2) * y));
+    }
+
+    /**
+     * @brief softplus of a forward-Laplacian state: f' = sigmoid(u), f'' = f' (1 - f').
+     */
+    template<Numeric T>
+    LaplacianState<T> softplus(const LaplacianState<T> &s) {
+        using namespace tensor::ops;
+        auto dy = tensor::ops::sigmoid(s.u);
+        return elementwise(s, tensor::ops::softplus(s.u), dy, dy * (T(1) - dy));
+    }
+
+    /**
+     * @brief swish of a forward-Laplacian state, with s = sigmoid(u):
+     * f' = s (1 + u (1 - s)), f'' = s (1 - s) (2 + u (1 - 2 s)).
+     */
+    template<Numeric T>
+    LaplacianState<T> swish(const LaplacianState<T> &s) {
+        using namespace tensor::ops;
+        auto sg = tensor::ops::sigmoid(s.u);
+        auto ds = sg * (T(1) - sg);
+        return elementwise(s, s.u * sg, sg + s.u * ds, ds * (T(2) + s.u * (T(1) - T(2) * sg)));
+    }
+
+    /**
+     * @brief ReLU of a forward-Laplacian state: f' is a constant step, f'' = 0 almost everywhere.
+     */
+    template<Numeric T>
+    LaplacianState<T> relu(const LaplacianState<T> &s) {
+        using namespace tensor::ops;
+        auto step = tensor::zeros<T>(s.u->shape);
+        for (size_t i = 0; i < step->data.size(); ++i) step->data[i] = s.u->data[i] > 0 ? T(1) : T(0);
+        return {tensor::ops::relu(s.u), s.J * step, s.L * step};
+    }
+
+}
+
+#endif
@@ -5,6 +5,8 @@
 #include "utils/tensor_utils.hpp"
 #include "ops/matmul.hpp"
 #include "ops/arithmetic.hpp"
+#include "nn/laplacian.hpp"
+#include "nn/taylor.hpp"
 
 
 namespace tensor::nn {
@@ -27,6 +29,24 @@ class Layer {
          * @brief Forward pass
          */
         virtual TensorS<T> operator()(const TensorS<T>) const = 0;
+
+        /**
+         * @brief Forward-Laplacian pass
+         *
+         * @throws std::runtime_error if the layer does not support it
+         */
+        virtual LaplacianState<T> operator()(const LaplacianState<T>&) const {
+            throw std::runtime_error("Layer does not implement the forward-Laplacian pass");
+        }
+
+        /**
+         * @brief Taylor-mode pass
+         *
+         * @throws std::runtime_error if the layer does not support it
+         */
+        virtual TaylorState<T> operator()(const TaylorState<T>&) const {
+            throw std::runtime_error("Layer does not implement the Taylor-mode pass");
+        }
 };
 
 /**
@@ -53,6 +73,24 @@ class Linear: public Layer<T> {
             return tensor::ops::broadcast_add(tensor::ops::matmul(x, W), b);
         }
 
+        /**
+         * @brief Forward-Laplacian pass: the layer is affine, so J' = J_k W and L' = L W.
+         */
+        LaplacianState<T> operator()(const LaplacianState<T>& s) const override
+        {
+            return {(*this)(s.u), tensor::ops::bmm(s.J, W), tensor::ops::matmul(s.L, W)};
+        }
+
+        /**
+         * @brief Taylor-mode pass: the bias only enters the constant coefficient.
+         */
+        TaylorState<T> operator()(const TaylorState<T>& s) const override
+        {
+            TaylorState<T> out{{(*this)(s.c[0])}};
+            for (size_t j = 1; j < s.c.size(); ++j) out.c.push_back(tensor::ops::matmul(s.c[j], W));
+            return out;
+        }
+
     private:
         TensorS<T> W, b;
 };
@@ -0,0 +1,93 @@
+#ifndef MLP_HPP
+#define MLP_HPP
+
+#include "nn/layers.hpp"
+#include "nn/model.hpp"
+#include "ops/activations.hpp"
+
+namespace tensor::nn {
+
+    /**
+     * @brief Activation applied after every hidden layer of an MLP.
+     */
+    enum class Activation { Tanh, Sin, Sigmoid, Softplus, Swish, Relu };
+
+    /**
+     * @brief Fully connected network with the same activation after every hidden layer.
+     *
+     * The ordinary, forward-Laplacian and Taylor-mode passes share the same
+     * expression, since layers and activations are overloaded on every state.
+     * Custom models follow the same pattern: inherit from Model, implement the
+     * forward pass (and optionally the other passes with the same expression) and
+     * expose every trainable parameter through getParams, so that optimizers can
+     * update them.
+     *
+     * @tparam T Numeric type, dual numbers included
+     */
+    template <Numeric T>
+    struct MLP : Model<T> {
+
+        /**
+         * @param widths Input size, hidden sizes and output size
+         * @param std Standard deviation of the initial weights
+         * @param activation Activation of the hidden layers
+         * @throws std::runtime_error if fewer than two widths are given
+         */
+        MLP(const std::vector<typename Tensor<T>::shape_type> &widths, T std = 1.0,
+            Activation activation = Activation::Tanh) : activation(activation)
+        {
+            if (widths.size() < 2) throw std::runtime_error("MLP expects at least the input and output sizes");
+            layers.reserve(widths.size() - 1);
+            for (size_t k = 0; k + 1 < widths.size(); ++k) layers.emplace_back(widths[k], widths[k + 1], std);
+        }
+
+        /// Forward expression, shared by every pass
+        template <typename X>
+        X forward(const X &input) const {
+            X u = layers[0](input);
+            for (size_t k = 1; k < layers.size(); ++k) u = layers[k](activate(u));
+            return u;
+        }
+
+        TensorS<T> operator()(const TensorS<T> &input) const override { return forward(input); }
+
+        LaplacianState<T> operator()(const LaplacianState<T> &input) const override { return forward(input); }
+
+        TaylorState<T> operator()(const TaylorState<T> &input) const override { return forward(input); }
+
+        std::vector<TensorS<T>> getParams() const override {
+            std::vector<TensorS<T>> params;
+            for (auto &layer: layers) {
+                auto p = layer.getParams();
+                params.insert(params.end(), p.begin(), p.end());
+            }
+            return params;
+        }
+
+    private:
+
+        template <typename X>
+        X activate(const X &u) const {
+            // The overloads on tensors live in tensor::ops, the ones on states in tensor::nn
+            using tensor::ops::tanh, tensor::ops::sin, tensor::ops::sigmoid, tensor::ops::softplus,
+                  tensor::ops::swish, tensor::ops::relu;
+            using tensor::nn::tanh, tensor::nn::sin, tensor::nn::sigmoid, tensor::nn::softplus,
+                  tensor::nn::swish, tensor::nn::relu;
+            switch (activation) {
+                case Activation::Sin: return sin(u);
+                case Activation::Sigmoid: return sigmoid(u);
+                case Activation::Softplus: return softplus(u);
+                case Activation::Swish: return swish(u);
+                case Activation::Relu: return relu(u);
+                default: return tanh(u);
+            }
+        }
+
+        std::vector<Linear<T>> layers;
+
+        Activation activation;
+    };
+
+}
+
+#endif
@@ -2,6 +2,8 @@
 #define MODEL_HPP
 
 #include "core/tensor_core.hpp"
+#include "nn/laplacian.hpp"
+#include "nn/taylor.hpp"
 
 namespace tensor::nn {
 
@@ -17,8 +19,171 @@ namespace tensor::nn {
 
         virtual std::vector<TensorS<T>> getParams() const = 0;
 
+        /**
+         * @brief Forward-Laplacian pass: propagates value, Jacobian and Laplacian together.
+         *
+         * Models usually implement it with the same expression as the ordinary
+         * forward pass, since layers and activations are overloaded on LaplacianState.
+         *
+         * @throws std::runtime_error if the model does not support it
+         */
+        virtual LaplacianState<T> operator()(const LaplacianState<T>&) const {
+            throw std::runtime_error("Model does not implement the forward-Laplacian pass");
+        }
+
+        /**
+         * @brief Taylor-mode pass: propagates a truncated Taylor series along an input direction.
+         *
+         * Implemented like the forward-Laplacian pass, with the same expression.
+         *
+         * @throws std::runtime_error if the model does not support it
+         */
+        virtual TaylorState<T> operator()(const TaylorState<T>&) const {
+            throw std::runtime_error("Model does not implement the Taylor-mode pass");
+        }
+
     };
 
+    /**
+     * @brief Copies the parameters of a model into a model of the same architecture,
+     * converting the element type (e.g. to evaluate it on dual numbers).
+     *
+     * @throws std::runtime_error if the parameters do not match
+     */
+    template <Numeric D, Numeric T>
+    void copy_params(const Model<T>& from, const Model<D>& to) {
+        auto src = from.getParams();
+        auto dst = to.getParams();
+        if (src.size() != dst.size()) throw std::runtime_error("copy_params: models do not match");
+        for (size_t i = 0; i < src.size(); ++i) {
+            if (src[i]->shape != dst[i]->shape) throw std::runtime_error("copy_params: models do not match");
+            for (size_t j = 0; j < src[i]->data.size(); ++j) dst[i]->data[j] = D(src[i]->data[j]);
+        }
+    }
+
+    /**
+     * @brief Value, input Jacobian and Laplacian of a model in a single forward pass.
+     *
+     * The input is seeded with J[k] = e_k and L = 0.
+     *
+     * @param model Model implementing the forward-Laplacian pass
+     * @param x Input points of shape (N, d)
+     * @return the output state
+     * @throws std::runtime_error if x is not 2D
+     */
+    template <Numeric T>
+    LaplacianState<T> forward_laplacian(const Model<T>& model, const TensorS<T>& x) {
+        if (x->shape.size() != 2) throw std::runtime_error("forward_laplacian expects an input of shape (N, d)");
+        const size_t N = x->shape[0], d = x->shape[1];
+        auto J = tensor::zeros<T>({d, N, d});
+        for (size_t k = 0; k < d; ++k)
+            for (size_t i = 0; i < N; ++i) J->data[(k * N + i) * d + k] = T(1);
+        return model(LaplacianState<T>{x, J, tensor::zeros<T>({N, d})});
+    }
+
+    /**
+     * @brief Exact Laplacian of a model with respect to its input, as a graph node.
+     *
+     * Unlike the diagonal Hessian left on a leaf input by backward, the result
+     * includes every cross term and is differentiable with respect to the
+     * parameters, so a PDE residual built from it is trained by a single backward.
+     *
+     * @param model Model implementing the forward-Laplacian pass
+     * @param x Input points of shape (N, d)
+     * @return Laplacian of shape (N, K)
+     */
+    template <Numeric T>
+    TensorS<T> laplacian(const Model<T>& model, const TensorS<T>& x) {
+        return forward_laplacian(model, x).L;
+    }
+
+    /**
+     * @brief Taylor coefficients of a model along an input direction, in a single forward pass.
+     *
+     * The input series is x + t v. Every op costs O(order^2) tensor operations.
+     *
+     * @param model Model implementing the Taylor-mode pass
+     * @param x Input points of shape (N, d)
+     * @param v Direction, of shape (N, d) or (1, d)
+     * @param order Highest derivative order
+     * @return the output series
+     * @throws std::runtime_error if the shapes do not match
+     */
+    template <Numeric T>
+    TaylorState<T> forward_taylor(const Model<T>& model, const TensorS<T>& x, const TensorS<T>& v, size_t order) {
+        if (x->shape.size() != 2 || v->shape.size() != 2 || v->shape[1] != x->shape[1]
+            || (v->shape[0] != x->shape[0] && v->shape[0] != 1))
+            throw std::runtime_error("forward_taylor expects x of shape (N, d) and v of shape (N, d) or (1, d)");
+
+        const size_t N = x->shape[0], d = x->shape[1];
+        auto dir = tensor::zeros<T>({N, d});
+        for (size_t i = 0; i < N * d; ++i) dir->data[i] = v->data[v->shape[0] == 1 ? i % d : i];
+
+        TaylorState<T> in{{x}};
+        if (order >= 1) in.c.push_back(dir);
+        for (size_t j = 2; j <= order; ++j) in.c.push_back(tensor::zeros<T>({N, d}));
+        return model(in);
+    }
+
+    /**
+     * @brief Directional derivatives d^k u(x + t v) / dt^k at t = 0 for k = 0..order, as graph nodes.
+     */
+    template <Numeric T>
+    std::vector<TensorS<T>> directional_derivatives(const Model<T>& model, const TensorS<T>& x,
+                                                    const TensorS<T>& v, size_t order) {
+        using namespace tensor::ops;
+        auto series = forward_taylor(model, x, v, order);
+        T factorial = 1;
+        for (size_t j = 2; j <= order; ++j) {
+            factorial *= T(j);
+            series.c[j] = series.c[j] * factorial;
+        }
+        return series.c;
+    }
+
+    /**
+     * @brief Biharmonic operator (Laplacian of the Laplacian) of a model, as a graph node.
+     *
+     * Built from fourth directional derivatives D_w = d^4 u / dt^4 along w:
+     *
+     *     u_iiii = D_{e_i},    u_iijj = (D_{e_i + e_j} + D_{e_i - e_j} - 2 D_{e_i} - 2 D_{e_j}) / 12
+     *
+     * which takes d^2 Taylor passes of order 4.
+     *
+     * @param model Model implementing the Taylor-mode pass
+     * @param x Input points of shape (N, d)
+     * @return sum_i u_iiii + 2 sum_{i<j} u_iijj, of shape (N, K)
+     */
+    template <Numeric T>
+    TensorS<T> biharmonic(const Model<T>& model, const TensorS<T>& x) {
+        using namespace tensor::ops;
+        const size_t d = x->shape.at(1);
+        auto fourth = [&](std::vector<T> w) {
+            auto dir = std::make_shared<Tensor<T>>(typename Tensor<T>::Shape{1, d}, std::move(w));
+            return directional_derivatives(model, x, dir, 4)[4];
+        };
+        auto axis = [&](size_t i, size_t j, T sign) {
+            std::vector<T> w(d, T(0));
+            w[i] += T(1);
+            w[j] += sign;
+            return w;
+        };
+
+        std::vector<TensorS<T>> diag(d);
+        TensorS<T> out;
+        for (size_t i = 0; i < d; ++i) {
+            diag[i] = fourth(axis(i, i, T(0)));
+            out = detail::accumulate(out, diag[i]);
+        }
+        for (size_t i = 0; i < d; ++i) {
+            for (size_t j = i + 1; j < d; ++j) {
+                auto mixed = fourth(axis(i, j, T(1))) + fourth(axis(i, j, T(-1))) - T(2) * (diag[i] + diag[j]);
+                out = out + mixed * (T(2) / T(12));
+            }
+        }
+        return out;
+    }
+
 }
 
 #endif
@@ -0,0 +1,145 @@
+#ifndef TAYLOR_HPP
+#define TAYLOR_HPP
+
+#include <numbers>
+#include <stdexcept>
+#include <vector>
+
+#include "core/tensor_core.hpp"
+#include "ops/activations.hpp"
+#include "ops/arithmetic.hpp"
+#include "utils/tensor_utils.hpp"
+
+namespace tensor::nn {
+
+    /**
+     * @brief Truncated Taylor series of an activation along an input direction.
+     *
+     * For u(x + t v) = sum_j c[j] t^j, c[j] = (1 / j!) d^j u / dt^j at t = 0.
+     * Every coefficient has the shape of u and is an ordinary graph node, so any
+     * residual built from them is differentiable with respect to the parameters.
+     */
+    template<Numeric T>
+    struct TaylorState {
+        std::vector<TensorS<T>> c;
+
+        size_t order() const { return c.size() - 1; }
+    };
+
+    namespace detail {
+
+        template<Numeric T>
+        TensorS<T> accumulate(TensorS<T> acc, TensorS<T> term) {
+            using namespace tensor::ops;
+            return acc ? acc + term : term;
+        }
+
+        /**
+         * @brief Coefficient j of the product of two series: sum_i a[i] b[j - i].
+         */
+        template<Numeric T>
+        TensorS<T> cauchy(const std::vector<TensorS<T>> &a, const std::vector<TensorS<T>> &b, size_t j) {
+            using namespace tensor::ops;
+            TensorS<T> out;
+            for (size_t i = 0; i <= j; ++i) out = accumulate(out, a[i] * b[j - i]);
+            return out;
+        }
+
+        /**
+         * @brief Coefficient j >= 1 of y with y' = g u': sum_{i=1..j} (i / j) u[i] g[j - i].
+         *
+         * Only needs g[0..j-1], so y and g can be built together one order at a time.
+         */
+        template<Numeric T>
+        TensorS<T> chain(const std::vector<TensorS<T>> &u, const std::vector<TensorS<T>> &g, size_t j) {
+            using namespace tensor::ops;
+            TensorS<T> out;
+            for (size_t i = 1; i <= j; ++i) out = accumulate(out, (T(i) / T(j)) * (u[i] * g[j - i]));
+            return out;
+        }
+
+    }
+
+    /**
+     * @brief tanh of a Taylor series: y' = g u' with g = 1 - y^2.
+     */
+    template<Numeric T>
+    TaylorState<T> tanh(const TaylorState<T> &s) {
+        using namespace tensor::ops;
+        const auto &u = s.c;
+        std::vector<TensorS<T>> y{tensor::ops::tanh(u[0])}, g{T(1) - pow(y[0], 2)};
+        for (size_t j = 1; j <= s.order(); ++j) {
+            y.push_back(detail::chain(u, g, j));
+            g.push_back(-detail::cauchy(y, y, j));
+        }
+        return {y};
+    }
+
+    /**
+     * @brief sin of a Taylor series, built together with cos: sin' = cos u', cos' = -sin u'.
+     */
+    template<Numeric T>
+    TaylorState<T> sin(const TaylorState<T> &s) {
+        using namespace tensor::ops;
+        const auto &u = s.c;
+        std::vector<TensorS<T>> y{tensor::ops::sin(u[0])}, c{tensor::ops::sin(u[0] + T(std::numbers::pi / 2))};
+        for (size_t j = 1; j <= s.order(); ++j) {
+            y.push_back(detail::chain(u, c, j));
+            c.push_back(-detail::chain(u, y, j));
+        }
+        return {y};
+    }
+
+    /**
+     * @brief sigmoid of a Taylor series: y' = g u' with g = y - y^2.
+     */
+    template<Numeric T>
+    TaylorState<T> sigmoid(const TaylorState<T> &s) {
+        using namespace tensor::ops;
+        const auto &u = s.c;
+        std::vector<TensorS<T>> y{tensor::ops::sigmoid(u[0])}, g{y[0] - pow(y[0], 2)};
+        for (size_t j = 1; j <= s.order(); ++j) {
+            y.push_back(detail::chain(u, g, j));
+            g.push_back(y[j] - detail::cauchy(y, y, j));
+        }
+        return {y};
+    }
+
+    /**
+     * @brief softplus of a Taylor series: y' = sigmoid(u) u'.
+     */
+    template<Numeric T>
+    TaylorState<T> softplus(const TaylorState<T> &s) {
+        const auto g = sigmoid(s).c;
+        std::vector<TensorS<T>> y{tensor::ops::softplus(s.c[0])};
+        for (size_t j = 1; j <= s.order(); ++j) y.push_back(detail::chain(s.c, g, j));
+        return {y};
+    }
+
+    /**
+     * @brief swish of a Taylor series, as the product of u and sigmoid(u).
+     */
+    template<Numeric T>
+    TaylorState<T> swish(const TaylorState<T> &s) {
+        const auto g = sigmoid(s).c;
+        std::vector<TensorS<T>> y;
+        for (size_t j = 0; j <= s.order(); ++j) y.push_back(detail::cauchy(s.c, g, j));
+        return {y};
+    }
+
+    /**
+     * @brief ReLU of a Taylor series: linear on each side of the kink.
+     */
+    template<Numeric T>
+    TaylorState<T> relu(const TaylorState<T> &s) {
+        using namespace tensor::ops;
+        auto step = tensor::zeros<T>(s.c[0]->shape);
+        for (size_t i = 0; i < step->data.size(); ++i) step->data[i] = s.c[0]->data[i] > 0 ? T(1) : T(0);
+        std::vector<TensorS<T>> y{tensor::ops::relu(s.c[0])};
+        for (size_t j = 1; j <= s.order(); ++j) y.push_back(s.c[j] * step);
+        return {y};
+    }
+
+}
+
+#endif
@@ -2,43 +2,95 @@
 #define ACTIVATION_HPP
 
 #include "core/tensor_core.hpp"
+#include "parallel/thread_pool.hpp"
 #include <memory>
+#include <utility>
+#include <tuple>
+#include <algorithm>
+#include <numbers>
 
 namespace tensor::ops {
 
     /**
-     * @brief Applies the ReLU activation function on the input tensor.
+     * @brief Applies an element-wise function with known first and second derivatives.
      *
-     * @tparam T Numeric type (float/double)
+     * The forward pass computes y = f(x) in a single pass. In the backward pass the
+     * derivatives are produced together by df(x, y), which returns the pair
+     * (dy/dx, d^2y/dx^2), and propagated as
+     *
+     *     grad_x += grad_y * dy
+     *     hess_x += hess_y * dy^2 + grad_y * d2y
+     *
+     * so every activation costs one fused pass in each direction. With stacked
+     * seed channels the derivatives are still evaluated once per element.
+     *
+     * @tparam T Numeric type
      * @param a Input tensor
-     * @return ReLU-activated tensor
+     * @param f Element-wise function
+     * @param df Derivatives of f, computed from the input and output values
+     * @param grad_function_name Name of the backward node
+     * @return Output tensor
      */
-    template<Numeric T>
-    TensorS<T> relu(TensorS<T> a) {
+    template<Numeric T, typename F, typename DF>
+    TensorS<T> unary_op(TensorS<T> a, F f, DF df, std::string grad_function_name) {
         std::vector<T> out_data(a->data.size());
-        std::transform(a->data.begin(), a->data.end(), out_data.begin(), [](T x) { return x > 0 ? x : 0; });
+        parallel::parallel_for(0, out_data.size(), [&](size_t lo, size_t hi) {
+            for (size_t i = lo; i < hi; ++i) out_data[i] = f(a->data[i]);
+        });
 
         auto out = std::make_shared<Tensor<T>>(
                 a->shape,
                 out_data,
                 a->requires_grad,
                 std::vector<TensorS<T>>{a},
-                "ReLuBackward"
+                std::move(grad_function_name)
         );
 
-        out->grad_fn = [a, out]() {
+        out->grad_fn = [a, out = out.get(), df]() {
             if (a->requires_grad) {
-                for (size_t i = 0; i < a->data.size(); ++i) {
-                    T mask = (out->data[i] > 0 ? 1 : 0);
-                    a->grad[i] += mask * out->grad[i];
-                    a->hess[i] += mask * out->hess[i];
-                }
+                auto &a_grad = a->grad_sink();
+                auto &a_hess = a->hess_sink();
+                const size_t C = out->channels(), n = a->data.size();
+                parallel::parallel_for(0, n, [&](size_t lo, size_t hi) {
+                    // The derivatives of a block of elements are computed once and
+                    // applied to every stacked channel
+                    constexpr size_t block = 256;
+                    T dy[block], d2y[block];
+                    for (size_t begin = lo; begin < hi; begin += block) {
+                        const size_t len = std::min(block, hi - begin);
+                        for (size_t j = 0; j < len; ++j)
+                            std::tie(dy[j], d2y[j]) = df(a->data[begin + j], out->data[begin + j]);
+                        for (size_t c = 0; c < C; ++c) {
+                            T *g = a_grad.data() + c * n + begin, *h = a_hess.data() + c * n + begin;
+                            const T *og = out->grad.data() + c * n + begin, *oh = out->hess.data() + c * n + begin;
+                            for (size_t j = 0; j < len; ++j) {
+                                g[j] += og[j] * dy[j];
+                                h[j] += oh[j] * dy[j] * dy[j] + og[j] * d2y[j];
+                            }
+                        }
+                    }
+                });
             }
         };
 
         return out;
     }
 
+    /**
+     * @brief Applies the ReLU activation function on the input tensor.
+     *
+     * @tparam T Numeric type (float/double)
+     * @param a Input tensor
+     * @return ReLU-activated tensor
+     */
+    template<Numeric T>
+    TensorS<T> relu(TensorS<T> a) {
+        return unary_op(a,
+                [](T x) { return x > 0 ? x : T(0); },
+                [](T, T y) { return std::pair<T, T>{y > 0 ? T(1) : T(0), T(0)}; },
+                "ReLuBackward");
+    }
+
     /**
      * @brief Applies the hyperbolic tangent activation function on the input tensor.
      *
@@ -48,32 +100,111 @@ namespace tensor::ops {
      */
     template<Numeric T>
     TensorS<T> tanh(TensorS<T> a) {
-        std::vector<T> out_data(a->data.size());
-        std::transform(a->data.begin(), a->data.end(), out_data.begin(), [](T x) { return std::tanh(x); });
+        return unary_op(a,
+                [](T x) { return math::tanh(x); },
+                [](T, T y) {
+                    T dy = 1 - y * y;
+                    return std::pair<T, T>{dy, -2 * y * dy};
+                },
+                "TanhBackward");
+    }
 
-        auto out = std::make_shared<Tensor<T>>(
-                a->shape,
-                out_data,
-                a->requires_grad,
-                std::vector<TensorS<T>>{a},
-                "TanhBackward"
-        );
+    /**
+     * @brief Applies the sine function on the input tensor.
+     *
+     * Used as activation of SIREN-style networks for oscillatory solutions.
+     *
+     * @tparam T Numeric type
+     * @param a Input tensor
+     * @return Output tensor
+     */
+    template<Numeric T>
+    TensorS<T> sin(TensorS<T> a) {
+        return unary_op(a,
+                [](T x) { return math::sin(x); },
+                [](T x, T y) { return std::pair<T, T>{math::cos(x), -y}; },
+                "SinBackward");
+    }
 
-        out->grad_fn = [a, out]() {
-            if (a->requires_grad) {
-                for (size_t i = 0; i < a->data.size(); ++i) {
-                    T dy = 1 - out->data[i] * out->data[i];
-                    T d2y = -2 * out->data[i] * dy;
+    /**
+     * @brief Applies the logistic sigmoid 1 / (1 + exp(-x)) on the input tensor.
+     *
+     * @tparam T Numeric type
+     * @param a Input tensor
+     * @return Output tensor
+     */
+    template<Numeric T>
+    TensorS<T> sigmoid(TensorS<T> a) {
+        return unary_op(a,
+                [](T x) { return T(1) / (T(1) + math::exp(-x)); },
+                [](T, T y) {
+                    T dy = y * (1 - y);
+                    return std::pair<T, T>{dy, dy * (1 - 2 * y)};
+                },
+                "SigmoidBackward");
+    }
 
-                    a->grad[i] += out->grad[i] * dy;
-                    a->hess[i] += out->hess[i] * dy * dy + out->grad[i] * d2y;
-                }
-            }
-        };
+    /**
+     * @brief Applies the softplus function log(1 + exp(x)) on the input tensor.
+     *
+     * Evaluated as max(x, 0) + log1p(exp(-|x|)) to avoid overflow.
+     *
+     * @tparam T Numeric type
+     * @param a Input tensor
+     * @return Output tensor
+     */
+    template<Numeric T>
+    TensorS<T> softplus(TensorS<T> a) {
+        return unary_op(a,
+                [](T x) { return std::max(x, T(0)) + math::log1p(math::exp(-math::abs(x))); },
+                [](T x, T) {
+                    T s = T(1) / (T(1) + math::exp(-x));
+                    return std::pair<T, T>{s, s * (1 - s)};
+                },
+                "SoftplusBackward");
+    }
 
-        return out;
+    /**
+     * @brief Applies the exact GELU activation x * Phi(x) on the input tensor.
+     *
+     * Phi is the standard normal CDF; with phi its density the derivatives are
+     * Phi(x) + x phi(x) and phi(x) (2 - x^2).
+     *
+     * @tparam T Numeric type
+     * @param a Input tensor
+     * @return Output tensor
+     */
+    template<Numeric T>
+    TensorS<T> gelu(TensorS<T> a) {
+        return unary_op(a,
+                [](T x) { return x * T(0.5) * (1 + math::erf(x / T(std::numbers::sqrt2))); },
+                [](T x, T) {
+                    T cdf = T(0.5) * (1 + math::erf(x / T(std::numbers::sqrt2)));
+                    T pdf = math::exp(T(-0.5) * x * x) * T(std::numbers::inv_sqrtpi) / T(std::numbers::sqrt2);
+                    return std::pair<T, T>{cdf + x * pdf, pdf * (2 - x * x)};
+                },
+                "GeluBackward");
+    }
+
+    /**
+     * @brief Applies the swish (SiLU) activation x * sigmoid(x) on the input tensor.
+     *
+     * @tparam T Numeric type
+     * @param a Input tensor
+     * @return Output tensor
+     */
+    template<Numeric T>
+    TensorS<T> swish(TensorS<T> a) {
+        return unary_op(a,
+                [](T x) { return x / (T(1) + math::exp(-x)); },
+                [](T x, T) {
+                    T s = T(1) / (T(1) + math::exp(-x));
+                    T ds = s * (1 - s);
+                    return std::pair<T, T>{s + x * ds, ds * (2 + x * (1 - 2 * s))};
+                },
+                "SwishBackward");
     }
 
 }
 
-#endif
\ No newline at end of file
+#endif
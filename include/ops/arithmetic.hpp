@@ -2,13 +2,18 @@
 #define ARITHMETIC_HPP
 
 #include "core/tensor_core.hpp"
+#include "ops/broadcast.hpp"
+#include "ops/reductions.hpp"
 #include <cmath>
 #include <numeric>
 
 namespace tensor::ops {
 
         /**
-         * @brief Computes the element-wise sum of two tensors with the same shape.
+         * @brief Computes the element-wise sum of two tensors with broadcasting.
+         *
+         * The shapes of a and b are broadcast NumPy-style: they are aligned on
+         * their trailing dimensions and every dimension must either match or be 1.
          *
          * @tparam T Numeric type
          * @param a First input tensor
@@ -18,36 +23,48 @@ namespace tensor::ops {
          * @note As for every operation implemented in this library, the returned tensor
          * may be connected to the computational graph and linked to a gradient
          * function to propagate gradients and Hessians to its parent nodes.
-         * @throws std::runtime_error if the shapes of a and b do not match
+         * Gradients of a broadcast operand are reduced over the broadcast dimensions.
+         * @throws std::runtime_error if the shapes of a and b cannot be broadcast
          */
         template <Numeric T>
         TensorS<T> operator+(TensorS<T> a, TensorS<T> b)
         {
-            if (a->shape != b->shape) throw std::runtime_error("Tensors shapes do not match");
-            std::vector<T> out_data(a->data.size());
+            auto plan = broadcast_plan(a->shape, b->shape);
+            std::vector<T> out_data(plan.size);
 
-            for (size_t i = 0; i < a->data.size(); ++i) out_data[i] = a->data[i] + b->data[i];
+            parallel_broadcast_for_each(plan, [&](size_t i, size_t ia, size_t ib) {
+                out_data[i] = a->data[ia] + b->data[ib];
+            });
 
             auto out = std::make_shared<Tensor<T>>(
-                    a->shape,
+                    plan.shape,
                     out_data,
                     a->requires_grad || b->requires_grad,
                     std::vector<TensorS<T>>{a, b},
                     "AddBackward"
             );
 
-            out->grad_fn = [a, b, out]() {
+            out->grad_fn = [a, b, out = out.get(), plan]() {
+                const size_t C = out->channels(), n = plan.size, na = a->data.size(), nb = b->data.size();
                 if (a->requires_grad) {
-                    std::transform(a->grad.begin(), a->grad.end(), out->grad.begin(), a->grad.begin(),
-                                   [](T x, T y) { return x + y; });
-                    std::transform(a->hess.begin(), a->hess.end(), out->hess.begin(), a->hess.begin(),
-                                   [](T x, T y) { return x + y; });
+                    auto &a_grad = a->grad_sink();
+                    auto &a_hess = a->hess_sink();
+                    broadcast_accumulate(plan, na, [&](size_t i, size_t ia, size_t) {
+                        for (size_t c = 0; c < C; ++c) {
+                            a_grad[c * na + ia] += out->grad[c * n + i];
+                            a_hess[c * na + ia] += out->hess[c * n + i];
+                        }
+                    });
                 }
                 if (b->requires_grad) {
-                    std::transform(b->grad.begin(), b->grad.end(), out->grad.begin(), b->grad.begin(),
-                                   [](T x, T y) { return x + y; });
-                    std::transform(b->hess.begin(), b->hess.end(), out->hess.begin(), b->hess.begin(),
-                                   [](T x, T y) { return x + y; });
+                    auto &b_grad = b->grad_sink();
+                    auto &b_hess = b->hess_sink();
+                    broadcast_accumulate(plan, nb, [&](size_t i, size_t, size_t ib) {
+                        for (size_t c = 0; c < C; ++c) {
+                            b_grad[c * nb + ib] += out->grad[c * n + i];
+                            b_hess[c * nb + ib] += out->hess[c * n + i];
+                        }
+                    });
                 }
             };
 
@@ -55,39 +72,66 @@ namespace tensor::ops {
         }
 
         /**
-         * @brief Computes the product between a scalar and a tensor.
+         * @brief Computes the element-wise affine map alpha * a + beta.
+         *
+         * Shared kernel of the tensor-scalar operators: with dy/dx = alpha and
+         * d^2y/dx^2 = 0 the Hessian is simply scaled by alpha^2.
          *
          * @tparam T Numeric type
          * @param a Input tensor
-         * @param scalar Input scalar value
+         * @param alpha Scale factor
+         * @param beta Offset
+         * @param grad_function_name Name of the backward node
          * @return Output tensor
          */
         template <Numeric T>
-        TensorS<T> operator*(TensorS<T> a, T scalar)
+        TensorS<T> affine(TensorS<T> a, T alpha, T beta, std::string grad_function_name)
         {
             std::vector<T> out_data(a->data.size());
-            std::transform(a->data.begin(), a->data.end(), out_data.begin(), [scalar](T x) { return x * scalar; });
+            parallel::parallel_for(0, out_data.size(), [&](size_t lo, size_t hi) {
+                for (size_t i = lo; i < hi; ++i) out_data[i] = alpha * a->data[i] + beta;
+            });
 
             auto out = std::make_shared<Tensor<T>>(
                     a->shape,
                     out_data,
                     a->requires_grad,
                     std::vector<TensorS<T>>{a},
-                    "MulScalarBackward"
+                    std::move(grad_function_name)
             );
 
-            out->grad_fn = [a, scalar, out]() {
+            out->grad_fn = [a, alpha, out = out.get()]() {
                 if (a->requires_grad) {
-                    std::transform(a->grad.begin(), a->grad.end(), out->grad.begin(), a->grad.begin(),
-                                   [scalar](T x, T y) { return x + y * scalar; });
-                    std::transform(a->hess.begin(), a->hess.end(), out->hess.begin(), a->hess.begin(),
-                                   [scalar](T x, T y) { return x + y * scalar * scalar; });
+                    auto &a_grad = a->grad_sink();
+                    auto &a_hess = a->hess_sink();
+                    const T alpha2 = alpha * alpha;
+                    // The stacked channels share the derivative, so they are one flat loop
+                    parallel::parallel_for(0, out->channels() * a->data.size(), [&](size_t lo, size_t hi) {
+                        for (size_t i = lo; i < hi; ++i) {
+                            a_grad[i] += out->grad[i] * alpha;
+                            a_hess[i] += out->hess[i] * alpha2;
+                        }
+                    });
                 }
             };
 
             return out;
         }
 
+        /**
+         * @brief Computes the product between a scalar and a tensor.
+         *
+         * @tparam T Numeric type
+         * @param a Input tensor
+         * @param scalar Input scalar value
+         * @return Output tensor
+         */
+        template <Numeric T>
+        TensorS<T> operator*(TensorS<T> a, T scalar)
+        {
+            return affine(a, scalar, T(0), "MulScalarBackward");
+        }
+
         /**
          * @brief Computes the product of a scalar and a tensor.
          */
@@ -98,41 +142,55 @@ namespace tensor::ops {
         }
 
         /**
-         * @brief Computes the element-wise product of two tensors.
+         * @brief Computes the element-wise product of two tensors with broadcasting.
          *
          * @tparam T Numeric type
          * @param a Input tensor
          * @param b Second input tensor
          * @return Output tensor
+         * @throws std::runtime_error if the shapes of a and b cannot be broadcast
          */
         template<Numeric T>
         TensorS<T> operator*(TensorS<T> a, TensorS<T> b)
         {
-            if (a->shape != b->shape) throw std::runtime_error("Tensors shapes do not match");
-            std::vector<T> out_data(a->data.size());
-            std::transform(a->data.begin(), a->data.end(), b->data.begin(), out_data.begin(),
-                           [](T x, T y) { return x * y; });
+            auto plan = broadcast_plan(a->shape, b->shape);
+            std::vector<T> out_data(plan.size);
+
+            parallel_broadcast_for_each(plan, [&](size_t i, size_t ia, size_t ib) {
+                out_data[i] = a->data[ia] * b->data[ib];
+            });
 
             auto out = std::make_shared<Tensor<T>>(
-                    a->shape,
+                    plan.shape,
                     out_data,
                     a->requires_grad || b->requires_grad,
                     std::vector<TensorS<T>>{a, b},
                     "MulBackward"
             );
 
-            out->grad_fn = [a, b, out]() {
+            out->grad_fn = [a, b, out = out.get(), plan]() {
+                const size_t C = out->channels(), n = plan.size, na = a->data.size(), nb = b->data.size();
                 if (a->requires_grad) {
-                    for (size_t i = 0; i < a->grad.size(); ++i) {
-                        a->grad[i] += out->grad[i] * b->data[i];
-                        a->hess[i] += out->hess[i] * b->data[i] * b->data[i];
-                    }
+                    auto &a_grad = a->grad_sink();
+                    auto &a_hess = a->hess_sink();
+                    broadcast_accumulate(plan, na, [&](size_t i, size_t ia, size_t ib) {
+                        const T dy = b->data[ib];
+                        for (size_t c = 0; c < C; ++c) {
+                            a_grad[c * na + ia] += out->grad[c * n + i] * dy;
+                            a_hess[c * na + ia] += out->hess[c * n + i] * dy * dy;
+                        }
+                    });
                 }
                 if (b->requires_grad) {
-                    for (size_t i = 0; i < a->grad.size(); ++i) {
-                        b->grad[i] += out->grad[i] * a->data[i];
-                        b->hess[i] += out->hess[i] * a->data[i] * a->data[i];
-                    }
+                    auto &b_grad = b->grad_sink();
+                    auto &b_hess = b->hess_sink();
+                    broadcast_accumulate(plan, nb, [&](size_t i, size_t ia, size_t ib) {
+                        const T dy = a->data[ia];
+                        for (size_t c = 0; c < C; ++c) {
+                            b_grad[c * nb + ib] += out->grad[c * n + i] * dy;
+                            b_hess[c * nb + ib] += out->hess[c * n + i] * dy * dy;
+                        }
+                    });
                 }
             };
 
@@ -140,34 +198,53 @@ namespace tensor::ops {
         }
 
         /**
-         * Computes the element-wise power of a tensor.
+         * @brief Computes the element-wise difference of two tensors with broadcasting.
          *
          * @tparam T Numeric type
-         * @param a Input tensor
-         * @param exp Exponent to which each element is raised
-         * @return A tensor containing a raised element-wise to exp
+         * @param a First input tensor
+         * @param b Second input tensor
+         * @return A tensor containing a - b
+         * @throws std::runtime_error if the shapes of a and b cannot be broadcast
          */
         template <Numeric T>
-        TensorS<T> pow(TensorS<T> a, int exp)
+        TensorS<T> operator-(TensorS<T> a, TensorS<T> b)
         {
-            std::vector<T> out_data(a->data.size());
-            std::transform(a->data.begin(), a->data.end(), out_data.begin(), [exp](T x) { return std::pow(x, exp); });
+            auto plan = broadcast_plan(a->shape, b->shape);
+            std::vector<T> out_data(plan.size);
+
+            parallel_broadcast_for_each(plan, [&](size_t i, size_t ia, size_t ib) {
+                out_data[i] = a->data[ia] - b->data[ib];
+            });
+
             auto out = std::make_shared<Tensor<T>>(
-                    a->shape,
+                    plan.shape,
                     out_data,
-                    a->requires_grad,
-                    std::vector<TensorS<T>>{a},
-                    "PowBackward"
+                    a->requires_grad || b->requires_grad,
+                    std::vector<TensorS<T>>{a, b},
+                    "SubBackward"
             );
 
-            out->grad_fn = [a, out, exp]() {
+            out->grad_fn = [a, b, out = out.get(), plan]() {
+                const size_t C = out->channels(), n = plan.size, na = a->data.size(), nb = b->data.size();
                 if (a->requires_grad) {
-                    for (size_t i = 0; i < a->grad.size(); ++i) {
-                        T fp = exp * std::pow(a->data[i], exp - 1);
-                        T fpp = exp * (exp - 1) * std::pow(a->data[i], exp - 2);
-                        a->grad[i] += out->grad[i] * fp;
-                        a->hess[i] += out->hess[i] * fp * fp + out->grad[i] * fpp;
-                    }
+                    auto &a_grad = a->grad_sink();
+                    auto &a_hess = a->hess_sink();
+                    broadcast_accumulate(plan, na, [&](size_t i, size_t ia, size_t) {
+                        for (size_t c = 0; c < C; ++c) {
+                            a_grad[c * na + ia] += out->grad[c * n + i];
+                            a_hess[c * na + ia] += out->hess[c * n + i];
+                        }
+                    });
+                }
+                if (b->requires_grad) {
+                    auto &b_grad = b->grad_sink();
+                    auto &b_hess = b->hess_sink();
+                    broadcast_accumulate(plan, nb, [&](size_t i, size_t, size_t ib) {
+                        for (size_t c = 0; c < C; ++c) {
+                            b_grad[c * nb + ib] -= out->grad[c * n + i];
+                            b_hess[c * nb + ib] += out->hess[c * n + i];
+                        }
+                    });
                 }
             };
 
@@ -175,30 +252,155 @@ namespace tensor::ops {
         }
 
         /**
-         * Computes the sum of all elements in a tensor.
+         * @brief Computes the element-wise negation of a tensor.
+         */
+        template <Numeric T>
+        TensorS<T> operator-(TensorS<T> a)
+        {
+            return affine(a, T(-1), T(0), "NegBackward");
+        }
+
+        /**
+         * @brief Adds a scalar to every element of a tensor.
+         */
+        template <Numeric T>
+        TensorS<T> operator+(TensorS<T> a, T scalar)
+        {
+            return affine(a, T(1), scalar, "AddScalarBackward");
+        }
+
+        /**
+         * @brief Adds a scalar to every element of a tensor.
+         */
+        template <Numeric T>
+        TensorS<T> operator+(T scalar, TensorS<T> a)
+        {
+            return a + scalar;
+        }
+
+        /**
+         * @brief Subtracts a scalar from every element of a tensor.
+         */
+        template <Numeric T>
+        TensorS<T> operator-(TensorS<T> a, T scalar)
+        {
+            return affine(a, T(1), -scalar, "SubScalarBackward");
+        }
+
+        /**
+         * @brief Subtracts every element of a tensor from a scalar.
+         */
+        template <Numeric T>
+        TensorS<T> operator-(T scalar, TensorS<T> a)
+        {
+            return affine(a, T(-1), scalar, "RSubScalarBackward");
+        }
+
+        /**
+         * @brief Computes the element-wise quotient of two tensors with broadcasting.
+         *
+         * With y = a / b the derivatives are dy/da = 1 / b, dy/db = -y / b
+         * and d^2y/db^2 = 2y / b^2.
          *
          * @tparam T Numeric type
-         * @param a Input tensor
-         * @return A scalar tensor containing the sum of all elements of a
+         * @param a Dividend tensor
+         * @param b Divisor tensor
+         * @return A tensor containing a / b
+         * @throws std::runtime_error if the shapes of a and b cannot be broadcast
+         */
+        template <Numeric T>
+        TensorS<T> operator/(TensorS<T> a, TensorS<T> b)
+        {
+            auto plan = broadcast_plan(a->shape, b->shape);
+            std::vector<T> out_data(plan.size);
+
+            parallel_broadcast_for_each(plan, [&](size_t i, size_t ia, size_t ib) {
+                out_data[i] = a->data[ia] / b->data[ib];
+            });
+
+            auto out = std::make_shared<Tensor<T>>(
+                    plan.shape,
+                    out_data,
+                    a->requires_grad || b->requires_grad,
+                    std::vector<TensorS<T>>{a, b},
+                    "DivBackward"
+            );
+
+            out->grad_fn = [a, b, out = out.get(), plan]() {
+                const size_t C = out->channels(), n = plan.size, na = a->data.size(), nb = b->data.size();
+                if (a->requires_grad) {
+                    auto &a_grad = a->grad_sink();
+                    auto &a_hess = a->hess_sink();
+                    broadcast_accumulate(plan, na, [&](size_t i, size_t ia, size_t ib) {
+                        T inv = T(1) / b->data[ib];
+                        for (size_t c = 0; c < C; ++c) {
+                            a_grad[c * na + ia] += out->grad[c * n + i] * inv;
+                            a_hess[c * na + ia] += out->hess[c * n + i] * inv * inv;
+                        }
+                    });
+                }
+                if (b->requires_grad) {
+                    auto &b_grad = b->grad_sink();
+                    auto &b_hess = b->hess_sink();
+                    broadcast_accumulate(plan, nb, [&](size_t i, size_t, size_t ib) {
+                        T dy = -out->data[i] / b->data[ib];
+                        T d2y = -2 * dy / b->data[ib];
+                        for (size_t c = 0; c < C; ++c) {
+                            b_grad[c * nb + ib] += out->grad[c * n + i] * dy;
+                            b_hess[c * nb + ib] += out->hess[c * n + i] * dy * dy + out->grad[c * n + i] * d2y;
+                        }
+                    });
+                }
+            };
+
+            return out;
+        }
+
+        /**
+         * @brief Divides every element of a tensor by a scalar.
+         */
+        template <Numeric T>
+        TensorS<T> operator/(TensorS<T> a, T scalar)
+        {
+            return affine(a, T(1) / scalar, T(0), "DivScalarBackward");
+        }
+
+        /**
+         * @brief Divides a scalar by every element of a tensor.
+         *
+         * With y = s / a the derivatives are dy/da = -y / a and d^2y/da^2 = 2y / a^2.
          */
         template <Numeric T>
-        TensorS<T> sum(TensorS<T> a) {
-            std::vector<T> out_data(1);
-            for (auto &val: a->data) out_data[0] += val;
+        TensorS<T> operator/(T scalar, TensorS<T> a)
+        {
+            std::vector<T> out_data(a->data.size());
+            parallel::parallel_for(0, out_data.size(), [&](size_t lo, size_t hi) {
+                for (size_t i = lo; i < hi; ++i) out_data[i] = scalar / a->data[i];
+            });
 
             auto out = std::make_shared<Tensor<T>>(
-                    typename Tensor<T>::Shape{1},
+                    a->shape,
                     out_data,
                     a->requires_grad,
                     std::vector<TensorS<T>>{a},
-                    "SumBackward"
+                    "RDivScalarBackward"
             );
 
-            out->grad_fn = [a, out]() {
-                if (!a->requires_grad) return;
-                for (size_t i = 0; i < a->data.size(); ++i) {
-                    a->grad[i] += out->grad[0];
-                    a->hess[i] += out->hess[0];
+            out->grad_fn = [a, out = out.get()]() {
+                if (a->requires_grad) {
+                    auto &a_grad = a->grad_sink();
+                    auto &a_hess = a->hess_sink();
+                    const size_t C = out->channels(), n = a->data.size();
+                    parallel::parallel_for(0, n, [&](size_t lo, size_t hi) {
+                        for (size_t i = lo; i < hi; ++i) {
+                            T dy = -out->data[i] / a->data[i];
+                            T d2y = -2 * dy / a->data[i];
+                            for (size_t k = i; k < C * n; k += n) {
+                                a_grad[k] += out->grad[k] * dy;
+                                a_hess[k] += out->hess[k] * dy * dy + out->grad[k] * d2y;
+                            }
+                        }
+                    });
                 }
             };
 
@@ -206,19 +408,55 @@ namespace tensor::ops {
         }
 
         /**
-         * Computes the mean of the elements in a tensor.
+         * Computes the element-wise power of a tensor.
          *
          * @tparam T Numeric type
          * @param a Input tensor
-         * @return A scalar tensor containing the mean
+         * @param exp Exponent to which each element is raised
+         * @return A tensor containing a raised element-wise to exp
          */
         template <Numeric T>
-        TensorS<T> mean(TensorS<T> a) {
-            return sum(a) * static_cast<T>(1. / static_cast<T>(a->data.size()));
+        TensorS<T> pow(TensorS<T> a, int exp)
+        {
+            std::vector<T> out_data(a->data.size());
+            parallel::parallel_for(0, out_data.size(), [&](size_t lo, size_t hi) {
+                for (size_t i = lo; i < hi; ++i) out_data[i] = math::pow(a->data[i], exp);
+            });
+
+            auto out = std::make_shared<Tensor<T>>(
+                    a->shape,
+                    out_data,
+                    a->requires_grad,
+                    std::vector<TensorS<T>>{a},
+                    "PowBackward"
+            );
+
+            out->grad_fn = [a, out = out.get(), exp]() {
+                if (a->requires_grad) {
+                    auto &a_grad = a->grad_sink();
+                    auto &a_hess = a->hess_sink();
+                    const size_t C = out->channels(), n = a->data.size();
+                    parallel::parallel_for(0, n, [&](size_t lo, size_t hi) {
+                        for (size_t i = lo; i < hi; ++i) {
+                            T fp = exp * math::pow(a->data[i], exp - 1);
+                            T fpp = exp * (exp - 1) * math::pow(a->data[i], exp - 2);
+                            for (size_t k = i; k < C * n; k += n) {
+                                a_grad[k] += out->grad[k] * fp;
+                                a_hess[k] += out->hess[k] * fp * fp + out->grad[k] * fpp;
+                            }
+                        }
+                    });
+                }
+            };
+
+            return out;
         }
 
         /**
-         * Computes the element-wise sum of two tensors with broadcasting.
+         * Computes the element-wise sum of a 2D tensor and a row vector.
+         *
+         * Specialized kernel for the bias addition of dense layers; see
+         * operator+ for general broadcasting.
          *
          * @tparam T Numeric type
          * @param a Input tensor
@@ -237,11 +475,13 @@ namespace tensor::ops {
             size_t K = a->shape[1];
 
             std::vector<T> out_data(N * K);
-            for (size_t i = 0; i < N; ++i) {
-                for (size_t j = 0; j < K; ++j) {
-                    out_data[i * K + j] = a->data[i * K + j] + b->data[j];
+            parallel::parallel_for(0, N, [&](size_t lo, size_t hi) {
+                for (size_t i = lo; i < hi; ++i) {
+                    for (size_t j = 0; j < K; ++j) {
+                        out_data[i * K + j] = a->data[i * K + j] + b->data[j];
+                    }
                 }
-            }
+            }, parallel::row_grain(K));
 
             auto out = std::make_shared<Tensor<T>>(
                     typename Tensor<T>::Shape{N, K},
@@ -251,18 +491,52 @@ namespace tensor::ops {
                     "BroadcastAddBackward"
             );
 
-            out->grad_fn = [a, b, out, N, K]() {
+            out->grad_fn = [a, b, out = out.get(), N, K]() {
+                const size_t C = out->channels();
                 if (a->requires_grad) {
-                    for (size_t i = 0; i < N * K; ++i) {
-                        a->grad[i] += out->grad[i];
-                        a->hess[i] += out->hess[i];
-                    }
+                    auto &a_grad = a->grad_sink();
+                    auto &a_hess = a->hess_sink();
+                    parallel::parallel_for(0, C * N * K, [&](size_t lo, size_t hi) {
+                        for (size_t i = lo; i < hi; ++i) {
+                            a_grad[i] += out->grad[i];
+                            a_hess[i] += out->hess[i];
+                        }
+                    });
                 }
                 if (b->requires_grad) {
-                    for (size_t i = 0; i < N; ++i) {
-                        for (size_t j = 0; j < K; ++j) {
-                            b->grad[j] += out->grad[i * K + j];
-                            b->hess[j] += out->hess[i * K + j];
+                    auto &b_grad = b->grad_sink();
+                    auto &b_hess = b->hess_sink();
+                    // Every chunk of rows reduces into its own partial, combined in chunk order.
+                    // In deterministic mode chunks have a fixed size, independent of the thread count.
+                    // The channels are stacked, so a chunk reduces the same rows of every channel.
+                    const size_t block_rows = std::max<size_t>(1, REDUCTION_BLOCK / K);
+                    auto part = parallel::deterministic()
+                                ? parallel::Partition{(N + block_rows - 1) / block_rows, block_rows}
+                                : parallel::partition(N, parallel::row_grain(C * K));
+                    const size_t width = 2 * C * K;
+                    std::vector<T> partial(part.chunks * width, T(0));
+                    parallel::pool().run_tasks(part.chunks, [&](size_t chunk) {
+                        const size_t hi = std::min(N, (chunk + 1) * part.chunk_size);
+                        for (size_t ch = 0; ch < C; ++ch) {
+                            T *g = partial.data() + chunk * width + ch * 2 * K;
+                            T *h = g + K;
+                            const T *og = out->grad.data() + ch * N * K;
+                            const T *oh = out->hess.data() + ch * N * K;
+                            for (size_t i = chunk * part.chunk_size; i < hi; ++i) {
+                                for (size_t j = 0; j < K; ++j) {
+                                    g[j] += og[i * K + j];
+                                    h[j] += oh[i * K + j];
+                                }
+                            }
+                        }
+                    });
+                    for (size_t chunk = 0; chunk < part.chunks; ++chunk) {
+                        for (size_t ch = 0; ch < C; ++ch) {
+                            const T *g = partial.data() + chunk * width + ch * 2 * K;
+                            for (size_t j = 0; j < K; ++j) {
+                                b_grad[ch * K + j] += g[j];
+                                b_hess[ch * K + j] += g[K + j];
+                            }
                         }
                     }
                 }
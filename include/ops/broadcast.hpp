@@ -0,0 +1,200 @@
+#ifndef BROADCAST_HPP
+#define BROADCAST_HPP
+
+#include <vector>
+#include <stdexcept>
+#include <string>
+#include <algorithm>
+
+#include "parallel/thread_pool.hpp"
+
+namespace tensor::ops {
+
+    /**
+     * @brief Iteration plan for a NumPy-style broadcast of two shapes.
+     *
+     * Stores the broadcast output shape and, for every (coalesced) output
+     * dimension, the stride of each operand. Broadcast dimensions have a
+     * zero stride, so operands are never materialized at the output size.
+     */
+    struct BroadcastPlan {
+        /// Shape of the broadcast result
+        std::vector<size_t> shape;
+
+        /// Number of elements of the broadcast result
+        size_t size = 1;
+
+        /// Coalesced iteration dimensions
+        std::vector<size_t> dims;
+
+        /// Strides of the first operand over dims (0 on broadcast dimensions)
+        std::vector<size_t> stride_a;
+
+        /// Strides of the second operand over dims (0 on broadcast dimensions)
+        std::vector<size_t> stride_b;
+    };
+
+    /**
+     * @brief Computes the broadcast plan of two shapes.
+     *
+     * Shapes are aligned on their trailing dimensions; two dimensions are
+     * compatible if they are equal or one of them is 1.
+     *
+     * @param a Shape of the first operand
+     * @param b Shape of the second operand
+     * @return The broadcast plan
+     * @throws std::runtime_error if the shapes cannot be broadcast together
+     */
+    inline BroadcastPlan broadcast_plan(const std::vector<size_t> &a, const std::vector<size_t> &b)
+    {
+        BroadcastPlan plan;
+        const size_t nd = std::max(a.size(), b.size());
+        plan.shape.assign(nd, 1);
+
+        std::vector<size_t> stride_a(nd, 0), stride_b(nd, 0);
+        size_t acc_a = 1, acc_b = 1;
+        for (size_t k = 0; k < nd; ++k) {
+            const size_t d = nd - 1 - k;
+            const size_t da = k < a.size() ? a[a.size() - 1 - k] : 1;
+            const size_t db = k < b.size() ? b[b.size() - 1 - k] : 1;
+            if (da != db && da != 1 && db != 1)
+                throw std::runtime_error("Tensors shapes cannot be broadcast together");
+
+            plan.shape[d] = std::max(da, db);
+            stride_a[d] = da == 1 ? 0 : acc_a;
+            stride_b[d] = db == 1 ? 0 : acc_b;
+            acc_a *= da;
+            acc_b *= db;
+            plan.size *= plan.shape[d];
+        }
+
+        // Merges adjacent dimensions that are laid out contiguously in both operands
+        for (size_t d = 0; d < nd; ++d) {
+            if (plan.shape[d] == 1) continue;
+            if (!plan.dims.empty()
+                && plan.stride_a.back() == stride_a[d] * plan.shape[d]
+                && plan.stride_b.back() == stride_b[d] * plan.shape[d]) {
+                plan.dims.back() *= plan.shape[d];
+                plan.stride_a.back() = stride_a[d];
+                plan.stride_b.back() = stride_b[d];
+            } else {
+                plan.dims.push_back(plan.shape[d]);
+                plan.stride_a.push_back(stride_a[d]);
+                plan.stride_b.push_back(stride_b[d]);
+            }
+        }
+        if (plan.dims.empty()) {
+            plan.dims.push_back(1);
+            plan.stride_a.push_back(0);
+            plan.stride_b.push_back(0);
+        }
+
+        return plan;
+    }
+
+    /**
+     * @brief Visits the elements of a broadcast with flat output index in [begin, end).
+     *
+     * Calls f(i, ia, ib) where i is the flat output index and ia, ib are the
+     * flat indices of the corresponding elements of the two operands.
+     * The innermost dimension is specialized for unit and zero strides so
+     * that the common cases compile to plain vectorizable loops.
+     *
+     * @param plan Broadcast plan computed by broadcast_plan
+     * @param begin First output index
+     * @param end One past the last output index
+     * @param f Element visitor
+     */
+    template<typename F>
+    void broadcast_for_each(const BroadcastPlan &plan, size_t begin, size_t end, F &&f)
+    {
+        const size_t nd = plan.dims.size();
+        const size_t inner = plan.dims[nd - 1];
+        const size_t sa = plan.stride_a[nd - 1];
+        const size_t sb = plan.stride_b[nd - 1];
+
+        // Multi-index and operand offsets of the first visited element
+        std::vector<size_t> idx(nd, 0);
+        size_t ia = 0, ib = 0, rem = begin;
+        for (size_t d = nd; d-- > 0;) {
+            idx[d] = rem % plan.dims[d];
+            rem /= plan.dims[d];
+            ia += idx[d] * plan.stride_a[d];
+            ib += idx[d] * plan.stride_b[d];
+        }
+
+        size_t i = begin;
+        while (i < end) {
+            const size_t j0 = idx[nd - 1];
+            const size_t len = std::min(inner - j0, end - i);
+            if (sa == 1 && sb == 1) {
+                for (size_t j = 0; j < len; ++j) f(i + j, ia + j, ib + j);
+            } else if (sa == 1 && sb == 0) {
+                for (size_t j = 0; j < len; ++j) f(i + j, ia + j, ib);
+            } else if (sa == 0 && sb == 1) {
+                for (size_t j = 0; j < len; ++j) f(i + j, ia, ib + j);
+            } else {
+                for (size_t j = 0; j < len; ++j) f(i + j, ia + j * sa, ib + j * sb);
+            }
+            i += len;
+            if (i >= end) break;
+
+            // Moves to the beginning of the next innermost row
+            ia -= j0 * sa;
+            ib -= j0 * sb;
+            idx[nd - 1] = 0;
+            for (size_t d = nd - 1; d-- > 0;) {
+                ia += plan.stride_a[d];
+                ib += plan.stride_b[d];
+                if (++idx[d] < plan.dims[d]) break;
+                ia -= plan.stride_a[d] * plan.dims[d];
+                ib -= plan.stride_b[d] * plan.dims[d];
+                idx[d] = 0;
+            }
+        }
+    }
+
+    /**
+     * @brief Visits every element of a broadcast.
+     */
+    template<typename F>
+    void broadcast_for_each(const BroadcastPlan &plan, F &&f)
+    {
+        broadcast_for_each(plan, 0, plan.size, f);
+    }
+
+    /**
+     * @brief Visits every element of a broadcast, splitting the output across the thread pool.
+     *
+     * f must only write to locations owned by the visited output index, e.g. the
+     * output itself or an operand that is not broadcast.
+     */
+    template<typename F>
+    void parallel_broadcast_for_each(const BroadcastPlan &plan, F &&f)
+    {
+        parallel::parallel_for(0, plan.size, [&](size_t lo, size_t hi) {
+            broadcast_for_each(plan, lo, hi, f);
+        });
+    }
+
+    /**
+     * @brief Visits every element of a broadcast to accumulate into an operand.
+     *
+     * If the operand has the size of the output every output index owns a distinct
+     * operand element and the loop runs on the thread pool; otherwise several output
+     * elements reduce into the same operand element and the loop runs serially.
+     *
+     * @param plan Broadcast plan computed by broadcast_plan
+     * @param operand_size Number of elements of the operand being accumulated
+     * @param f Element visitor
+     */
+    template<typename F>
+    void broadcast_accumulate(const BroadcastPlan &plan, size_t operand_size, F &&f)
+    {
+        if (operand_size == plan.size) parallel_broadcast_for_each(plan, f);
+        else broadcast_for_each(plan, f);
+    }
+
+}
+
+#endif
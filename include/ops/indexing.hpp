@@ -0,0 +1,315 @@
+#ifndef INDEXING_HPP
+#define INDEXING_HPP
+
+#include "core/tensor_core.hpp"
+#include "ops/reductions.hpp"
+#include <stdexcept>
+
+namespace tensor::ops {
+
+    /**
+     * @brief Concatenates tensors along a dimension.
+     *
+     * All tensors must have the same number of dimensions and the same size
+     * in every dimension except dim.
+     *
+     * @tparam T Numeric type
+     * @param tensors Input tensors
+     * @param dim Dimension along which the tensors are concatenated
+     * @return Output tensor
+     * @throws std::runtime_error if the shapes are not compatible
+     */
+    template<Numeric T>
+    TensorS<T> concat(const std::vector<TensorS<T>> &tensors, size_t dim = 0)
+    {
+        if (tensors.empty()) throw std::runtime_error("concat requires at least one tensor");
+
+        auto shape = tensors[0]->shape;
+        if (dim >= shape.size()) throw std::runtime_error("concat dimension out of range");
+
+        bool requires_grad = false;
+        size_t total = 0;
+        for (const auto &t: tensors) {
+            if (t->shape.size() != shape.size()) throw std::runtime_error("concat tensors must have the same rank");
+            for (size_t d = 0; d < shape.size(); ++d) {
+                if (d != dim && t->shape[d] != shape[d])
+                    throw std::runtime_error("concat tensors shapes do not match");
+            }
+            total += t->shape[dim];
+            requires_grad = requires_grad || t->requires_grad;
+        }
+        shape[dim] = total;
+
+        auto [outer, len, inner] = reduction_extents(shape, dim);
+        std::vector<T> out_data(outer * len * inner);
+
+        // Offset of each input along the concatenated dimension
+        std::vector<size_t> offsets;
+        offsets.reserve(tensors.size());
+        size_t offset = 0;
+        for (const auto &t: tensors) {
+            offsets.push_back(offset);
+            const size_t chunk = t->shape[dim] * inner;
+            for (size_t o = 0; o < outer; ++o) {
+                std::copy(t->data.begin() + o * chunk, t->data.begin() + (o + 1) * chunk,
+                          out_data.begin() + (o * len + offset) * inner);
+            }
+            offset += t->shape[dim];
+        }
+
+        auto out = std::make_shared<Tensor<T>>(
+                shape,
+                out_data,
+                requires_grad,
+                tensors,
+                "ConcatBackward"
+        );
+
+        out->grad_fn = [tensors, offsets, out = out.get(), dim, outer, len, inner]() {
+            // Every stacked channel is concatenated along dim: the outer rows of all channels follow each other
+            const size_t rows = out->channels() * outer;
+            for (size_t j = 0; j < tensors.size(); ++j) {
+                const auto &t = tensors[j];
+                if (!t->requires_grad) continue;
+                auto &t_grad = t->grad_sink();
+                auto &t_hess = t->hess_sink();
+                const size_t chunk = t->shape[dim] * inner;
+                for (size_t o = 0; o < rows; ++o) {
+                    const size_t src = (o * len + offsets[j]) * inner;
+                    for (size_t i = 0; i < chunk; ++i) {
+                        t_grad[o * chunk + i] += out->grad[src + i];
+                        t_hess[o * chunk + i] += out->hess[src + i];
+                    }
+                }
+            }
+        };
+
+        return out;
+    }
+
+    /**
+     * @brief Selects slices of a tensor along a dimension.
+     *
+     * The output has the shape of a with shape[dim] replaced by indices.size(),
+     * and slice k of the output is slice indices[k] of a. Indices may repeat;
+     * gradients of repeated slices are accumulated.
+     *
+     * This allows mini-batches to be read from a large dataset tensor through
+     * an index list, without permuting or copying the whole dataset.
+     *
+     * @tparam T Numeric type
+     * @param a Input tensor
+     * @param dim Dimension to index
+     * @param indices Indices of the selected slices
+     * @return Output tensor
+     * @throws std::runtime_error if an index is out of range
+     */
+    template<Numeric T>
+    TensorS<T> index_select(TensorS<T> a, size_t dim, std::vector<size_t> indices)
+    {
+        auto [outer, len, inner] = reduction_extents(a->shape, dim);
+        const size_t n = indices.size();
+        for (auto idx: indices) {
+            if (idx >= len) throw std::runtime_error("index_select index out of range");
+        }
+
+        auto shape = a->shape;
+        shape[dim] = n;
+        std::vector<T> out_data(outer * n * inner);
+        parallel::parallel_for(0, outer * n, [&](size_t lo, size_t hi) {
+            for (size_t row = lo; row < hi; ++row) {
+                const size_t o = row / n, k = row % n;
+                auto src = a->data.begin() + (o * len + indices[k]) * inner;
+                std::copy(src, src + inner, out_data.begin() + row * inner);
+            }
+        }, parallel::row_grain(inner));
+
+        auto out = std::make_shared<Tensor<T>>(
+                shape,
+                out_data,
+                a->requires_grad,
+                std::vector<TensorS<T>>{a},
+                "IndexSelectBackward"
+        );
+
+        out->grad_fn = [a, out = out.get(), indices = std::move(indices), outer, len, inner]() {
+            if (!a->requires_grad) return;
+            auto &a_grad = a->grad_sink();
+            auto &a_hess = a->hess_sink();
+            const size_t n = indices.size();
+            // The outer rows of the stacked channels follow each other
+            const size_t rows = out->channels() * outer;
+            for (size_t o = 0; o < rows; ++o) {
+                for (size_t k = 0; k < n; ++k) {
+                    const size_t dst = (o * len + indices[k]) * inner;
+                    const size_t src = (o * n + k) * inner;
+                    for (size_t i = 0; i < inner; ++i) {
+                        a_grad[dst + i] += out->grad[src + i];
+                        a_hess[dst + i] += out->hess[src + i];
+                    }
+                }
+            }
+        };
+
+        return out;
+    }
+
+    /**
+     * @brief Validates an index list for gather / scatter_add.
+     *
+     * The index tensor must have the rank of a and the same size in every
+     * dimension except dim, and every index must be smaller than a->shape[dim].
+     */
+    template<Numeric T>
+    void check_scatter_index(const TensorS<T> &a, size_t dim, const std::vector<size_t> &index,
+                             const std::vector<size_t> &index_shape)
+    {
+        if (dim >= a->shape.size() || index_shape.size() != a->shape.size())
+            throw std::runtime_error("index must have the same rank as the tensor");
+        size_t size = 1;
+        for (size_t d = 0; d < index_shape.size(); ++d) {
+            if (d != dim && index_shape[d] != a->shape[d])
+                throw std::runtime_error("index shape does not match the tensor shape");
+            size *= index_shape[d];
+        }
+        if (index.size() != size) throw std::runtime_error("index size does not match its shape");
+        for (auto idx: index) {
+            if (idx >= a->shape[dim]) throw std::runtime_error("index out of range");
+        }
+    }
+
+    /**
+     * @brief Gathers values of a tensor along a dimension.
+     *
+     * For a 2D tensor and dim = 0 computes out[i][j] = a[index[i][j]][j];
+     * for dim = 1 computes out[i][j] = a[i][index[i][j]].
+     *
+     * @tparam T Numeric type
+     * @param a Input tensor
+     * @param dim Dimension to index
+     * @param index Flat index list, row-major with shape index_shape
+     * @param index_shape Shape of the index list and of the output
+     * @return Output tensor
+     * @throws std::runtime_error if the index is not valid
+     */
+    template<Numeric T>
+    TensorS<T> gather(TensorS<T> a, size_t dim, std::vector<size_t> index, typename Tensor<T>::Shape index_shape)
+    {
+        check_scatter_index(a, dim, index, index_shape);
+        auto [outer, len, inner] = reduction_extents(a->shape, dim);
+        const size_t n = index_shape[dim];
+
+        std::vector<T> out_data(index.size());
+        for (size_t o = 0; o < outer; ++o) {
+            for (size_t k = 0; k < n; ++k) {
+                for (size_t i = 0; i < inner; ++i) {
+                    const size_t j = (o * n + k) * inner + i;
+                    out_data[j] = a->data[(o * len + index[j]) * inner + i];
+                }
+            }
+        }
+
+        auto out = std::make_shared<Tensor<T>>(
+                std::move(index_shape),
+                out_data,
+                a->requires_grad,
+                std::vector<TensorS<T>>{a},
+                "GatherBackward"
+        );
+
+        out->grad_fn = [a, out = out.get(), index = std::move(index), outer, len, inner, n]() {
+            if (!a->requires_grad) return;
+            auto &a_grad = a->grad_sink();
+            auto &a_hess = a->hess_sink();
+            const size_t C = out->channels(), size = a->data.size();
+            for (size_t c = 0; c < C; ++c) {
+                for (size_t o = 0; o < outer; ++o) {
+                    for (size_t k = 0; k < n; ++k) {
+                        for (size_t i = 0; i < inner; ++i) {
+                            const size_t j = (o * n + k) * inner + i;
+                            const size_t src = c * size + (o * len + index[j]) * inner + i;
+                            a_grad[src] += out->grad[c * index.size() + j];
+                            a_hess[src] += out->hess[c * index.size() + j];
+                        }
+                    }
+                }
+            }
+        };
+
+        return out;
+    }
+
+    /**
+     * @brief Adds the values of src into a copy of a at the given indices.
+     *
+     * For a 2D tensor and dim = 0 computes out = a and out[index[i][j]][j] += src[i][j];
+     * for dim = 1 computes out[i][index[i][j]] += src[i][j]. The index list has the
+     * shape of src.
+     *
+     * @tparam T Numeric type
+     * @param a Input tensor
+     * @param dim Dimension to index
+     * @param index Flat index list, row-major with the shape of src
+     * @param src Values to scatter
+     * @return Output tensor with the shape of a
+     * @throws std::runtime_error if the index is not valid
+     */
+    template<Numeric T>
+    TensorS<T> scatter_add(TensorS<T> a, size_t dim, std::vector<size_t> index, TensorS<T> src)
+    {
+        check_scatter_index(a, dim, index, src->shape);
+        auto [outer, len, inner] = reduction_extents(a->shape, dim);
+        const size_t n = src->shape[dim];
+
+        std::vector<T> out_data(a->data);
+        for (size_t o = 0; o < outer; ++o) {
+            for (size_t k = 0; k < n; ++k) {
+                for (size_t i = 0; i < inner; ++i) {
+                    const size_t j = (o * n + k) * inner + i;
+                    out_data[(o * len + index[j]) * inner + i] += src->data[j];
+                }
+            }
+        }
+
+        auto out = std::make_shared<Tensor<T>>(
+                a->shape,
+                out_data,
+                a->requires_grad || src->requires_grad,
+                std::vector<TensorS<T>>{a, src},
+                "ScatterAddBackward"
+        );
+
+        out->grad_fn = [a, src, out = out.get(), index = std::move(index), outer, len, inner, n]() {
+            const size_t C = out->channels(), size = out->data.size();
+            if (a->requires_grad) {
+                auto &a_grad = a->grad_sink();
+                auto &a_hess = a->hess_sink();
+                for (size_t i = 0; i < C * size; ++i) {
+                    a_grad[i] += out->grad[i];
+                    a_hess[i] += out->hess[i];
+                }
+            }
+            if (src->requires_grad) {
+                auto &src_grad = src->grad_sink();
+                auto &src_hess = src->hess_sink();
+                for (size_t c = 0; c < C; ++c) {
+                    for (size_t o = 0; o < outer; ++o) {
+                        for (size_t k = 0; k < n; ++k) {
+                            for (size_t i = 0; i < inner; ++i) {
+                                const size_t j = (o * n + k) * inner + i;
+                                const size_t dst = c * size + (o * len + index[j]) * inner + i;
+                                src_grad[c * index.size() + j] += out->grad[dst];
+                                src_hess[c * index.size() + j] += out->hess[dst];
+                            }
+                        }
+                    }
+                }
+            }
+        };
+
+        return out;
+    }
+
+}
+
+#endif
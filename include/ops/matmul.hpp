@@ -2,7 +2,9 @@
 #define MATMUL_HPP
 
 #include "core/tensor_core.hpp"
+#include "parallel/thread_pool.hpp"
 #include <memory>
+#include <array>
 
 #ifdef USE_BLAS
     #include <cblas.h>
@@ -12,10 +14,16 @@
 #endif
 
 #if BLAS
+template<Numeric T>
+void dual_bmm(const T *a, const T *b, T *c, size_t batch, size_t m, size_t n, size_t p,
+              size_t stride_a, size_t stride_b, size_t stride_c, T beta);
+
 template<Numeric T>
 void raw_matmul(const std::vector<T> &a, const std::vector<T> &b, std::vector<T> &c, size_t m, size_t n, size_t p, T beta = 0.0)
 {
-    if constexpr (std::is_same_v<T, float>) {
+    if constexpr (is_dual<T>::value) {
+        dual_bmm(a.data(), b.data(), c.data(), 1, m, n, p, 0, 0, 0, beta);
+    } else if constexpr (std::is_same_v<T, float>) {
         cblas_sgemm(
             CblasRowMajor,
             CblasNoTrans, CblasNoTrans,
@@ -43,6 +51,90 @@ void raw_matmul(const std::vector<T> &a, const std::vector<T> &b, std::vector<T>
         );
     }
 }
+
+/**
+ * @brief Performs a strided batched matrix multiplication with BLAS.
+ *
+ * For every batch index i computes C_i = A_i * B_i + beta * C_i, where
+ * A_i = a + i * stride_a (m * n), B_i = b + i * stride_b (n * p) and
+ * C_i = c + i * stride_c (m * p). A zero stride broadcasts the same matrix
+ * to every batch; a zero output stride accumulates every batch into C.
+ *
+ * When B is shared and A, C are contiguous the whole batch is collapsed into
+ * a single (batch * m, n) x (n, p) GEMM call.
+ */
+template<Numeric T>
+void raw_bmm(const T *a, const T *b, T *c, size_t batch, size_t m, size_t n, size_t p,
+             size_t stride_a, size_t stride_b, size_t stride_c, T beta = 0.0)
+{
+    auto gemm = [](const T *a, const T *b, T *c, size_t m, size_t n, size_t p, T beta) {
+        if constexpr (is_dual<T>::value) {
+            dual_bmm(a, b, c, 1, m, n, p, 0, 0, 0, beta);
+        } else if constexpr (std::is_same_v<T, float>) {
+            cblas_sgemm(CblasRowMajor, CblasNoTrans, CblasNoTrans,
+                        m, p, n, 1.0, a, n, b, p, beta, c, p);
+        } else {
+            cblas_dgemm(CblasRowMajor, CblasNoTrans, CblasNoTrans,
+                        m, p, n, 1.0, a, n, b, p, beta, c, p);
+        }
+    };
+
+    if (stride_b == 0 && stride_a == m * n && stride_c == m * p) {
+        gemm(a, b, c, batch * m, n, p, beta);
+        return;
+    }
+    for (size_t i = 0; i < batch; ++i) {
+        // When accumulating into a shared output beta only applies to the first batch
+        T beta_i = (stride_c == 0 && i > 0) ? T(1) : beta;
+        gemm(a + i * stride_a, b + i * stride_b, c + i * stride_c, m, n, p, beta_i);
+    }
+}
+
+/**
+ * @brief Strided batched multiplication of dual matrices, split into products of their parts.
+ *
+ * With A = A_0 + sum_k A_k e_k and B = B_0 + sum_k B_k e_k,
+ *
+ *     C_0 = A_0 B_0,    C_k = A_k B_0 + A_0 B_k
+ *
+ * so the product runs as 1 + 2N GEMM calls on the value and tangent planes
+ * (recursively for nested dual numbers). beta must be a constant.
+ */
+template<Numeric T>
+void dual_bmm(const T *a, const T *b, T *c, size_t batch, size_t m, size_t n, size_t p,
+              size_t stride_a, size_t stride_b, size_t stride_c, T beta)
+{
+    using S = decltype(T::val);
+    constexpr size_t N = std::tuple_size_v<decltype(T::eps)>;
+
+    const size_t len_a = (batch - 1) * stride_a + m * n;
+    const size_t len_b = (batch - 1) * stride_b + n * p;
+    const size_t len_c = (batch - 1) * stride_c + m * p;
+    const S beta_s = beta.val;
+
+    // Component j of every element: the value for j = 0, tangent j - 1 otherwise
+    auto plane = [](const T *x, size_t len, size_t j) {
+        std::vector<S> out(len);
+        for (size_t i = 0; i < len; ++i) out[i] = j == 0 ? x[i].val : x[i].eps[j - 1];
+        return out;
+    };
+    auto c_plane = [&](size_t j) {
+        return beta_s == S(0) ? std::vector<S>(len_c) : plane(c, len_c, j);
+    };
+
+    auto a0 = plane(a, len_a, 0), b0 = plane(b, len_b, 0);
+    auto c0 = c_plane(0);
+    raw_bmm(a0.data(), b0.data(), c0.data(), batch, m, n, p, stride_a, stride_b, stride_c, beta_s);
+
+    for (size_t k = 0; k < N; ++k) {
+        auto ak = plane(a, len_a, k + 1), bk = plane(b, len_b, k + 1);
+        auto ck = c_plane(k + 1);
+        raw_bmm(ak.data(), b0.data(), ck.data(), batch, m, n, p, stride_a, stride_b, stride_c, beta_s);
+        raw_bmm(a0.data(), bk.data(), ck.data(), batch, m, n, p, stride_a, stride_b, stride_c, S(1));
+        for (size_t i = 0; i < len_c; ++i) c[i].eps[k] = ck[i];
+    }
+    for (size_t i = 0; i < len_c; ++i) c[i].val = c0[i];
+}
 #else
 #warning "BLAS DISABLED"
 
@@ -66,15 +158,52 @@ void raw_matmul(const std::vector<T> &a, const std::vector<T> &b, std::vector<T>
 template<Numeric T>
 void raw_matmul(const std::vector<T> &a, const std::vector<T> &b, std::vector<T> &c, size_t m, size_t n, size_t p, T beta = 0.0)
 {
-    for (size_t i = 0; i < m; ++i) {
-        for (size_t j = 0; j < p; ++j) {
-            T sum = 0;
-            for (size_t k = 0; k < n; ++k) {
-                sum += a[i * n + k] * b[k * p + j];
+    tensor::parallel::parallel_for(0, m, [&](size_t lo, size_t hi) {
+        for (size_t i = lo; i < hi; ++i) {
+            for (size_t j = 0; j < p; ++j) {
+                T sum = 0;
+                for (size_t k = 0; k < n; ++k) {
+                    sum += a[i * n + k] * b[k * p + j];
+                }
+                c[i * p + j] = sum + (beta*c[i*p+j]);
             }
-            c[i * p + j] = sum + (beta*c[i*p+j]);
         }
-    }
+    }, tensor::parallel::row_grain(n * p));
+}
+
+/**
+ * @brief Performs a strided batched matrix multiplication.
+ *
+ * For every batch index i computes C_i = A_i * B_i + beta * C_i, where
+ * A_i = a + i * stride_a (m * n), B_i = b + i * stride_b (n * p) and
+ * C_i = c + i * stride_c (m * p). A zero stride broadcasts the same matrix
+ * to every batch; a zero output stride accumulates every batch into C.
+ *
+ * @note Intended for internal use when BLAS is not available.
+ */
+template<Numeric T>
+void raw_bmm(const T *a, const T *b, T *c, size_t batch, size_t m, size_t n, size_t p,
+             size_t stride_a, size_t stride_b, size_t stride_c, T beta = 0.0)
+{
+    // Rows are split across threads; the batches of a row are processed by the
+    // same task, so a shared output row is accumulated without races
+    tensor::parallel::parallel_for(0, m, [&](size_t lo, size_t hi) {
+        for (size_t bi = 0; bi < batch; ++bi) {
+            const T *ab = a + bi * stride_a;
+            const T *bb = b + bi * stride_b;
+            T *cb = c + bi * stride_c;
+            T beta_i = (stride_c == 0 && bi > 0) ? T(1) : beta;
+            for (size_t i = lo; i < hi; ++i) {
+                for (size_t j = 0; j < p; ++j) {
+                    T sum = 0;
+                    for (size_t k = 0; k < n; ++k) {
+                        sum += ab[i * n + k] * bb[k * p + j];
+                    }
+                    cb[i * p + j] = sum + (beta_i * cb[i * p + j]);
+                }
+            }
+        }
+    }, tensor::parallel::row_grain(batch * n * p));
 }
 #endif
 
@@ -101,6 +230,33 @@ std::vector<T> transpose(const std::vector<T>& mat, size_t rows, size_t cols)
     return result;
 }
 
+/**
+ * Computes the transpose of every matrix in a batch stored in a flat vector.
+ *
+ * @tparam T Numeric type (e.g., float, double)
+ * @param mat Input batch of matrices stored as a flat vector
+ * @param batch Number of matrices in the batch
+ * @param rows Number of rows of each matrix
+ * @param cols Number of columns of each matrix
+ * @return A std::vector containing the batch of transposed matrices
+ */
+template <typename T>
+std::vector<T> batch_transpose(const std::vector<T>& mat, size_t batch, size_t rows, size_t cols)
+{
+    std::vector<T> result(batch * cols * rows);
+
+    for (size_t b = 0; b < batch; ++b) {
+        const size_t offset = b * rows * cols;
+        for (size_t i = 0; i < rows; ++i) {
+            for (size_t j = 0; j < cols; ++j) {
+                result[offset + j * rows + i] = mat[offset + i * cols + j];
+            }
+        }
+    }
+
+    return result;
+}
+
 namespace tensor::ops {
 
     /**
@@ -134,19 +290,110 @@ namespace tensor::ops {
                 "MatMulBackward"
         );
 
-        out->grad_fn = [A, B, out, m, n, p]() {
+        out->grad_fn = [A, B, out = out.get(), m, n, p]() {
+            const size_t C = out->channels();
             if (A->requires_grad) {
+                // The stacked channels of the output are C * m rows: one GEMM for all of them
                 auto BT = transpose(B->data, n, p);
-                raw_matmul(out->grad, BT, A->grad, m, p, n, T(1));
+                raw_matmul(out->grad, BT, A->grad_sink(), C * m, p, n, T(1));
                 for (auto &x: BT) x *= x;
-                raw_matmul(out->hess, BT, A->hess, m, p, n, T(1));
+                raw_matmul(out->hess, BT, A->hess_sink(), C * m, p, n, T(1));
             }
 
             if (B->requires_grad) {
+                // A^T times every channel of the output, as a batch sharing A^T
                 auto AT = transpose(A->data, m, n);
-                raw_matmul(AT, out->grad, B->grad, n, m, p, T(1));
+                raw_bmm(AT.data(), out->grad.data(), B->grad_sink().data(), C, n, m, p, 0, m * p, n * p, T(1));
                 for (auto &x: AT) x *= x;
-                raw_matmul(AT, out->hess, B->hess, n, m, p, T(1));
+                raw_bmm(AT.data(), out->hess.data(), B->hess_sink().data(), C, n, m, p, 0, m * p, n * p, T(1));
+            }
+        };
+
+        return out;
+    }
+    /**
+     * Computes a batched matrix multiplication of two tensors.
+     *
+     * A has shape (B, M, K) and B has shape (B, K, N), the output has shape (B, M, N).
+     * Either operand may be a 2D matrix or have a batch dimension of 1: it is then
+     * shared across the whole batch and its gradient is reduced over the batch.
+     *
+     * @tparam T Numeric type
+     * @param A First input tensor
+     * @param B Second input tensor
+     * @return Output tensor of shape (B, M, N)
+     * @throws std::runtime_error if the shapes are not compatible
+     */
+    template<Numeric T>
+    TensorS<T> bmm(TensorS<T> A, TensorS<T> B) {
+        auto unpack = [](const TensorS<T> &t) -> std::array<size_t, 3> {
+            if (t->shape.size() == 2) return {1, t->shape[0], t->shape[1]};
+            if (t->shape.size() == 3) return {t->shape[0], t->shape[1], t->shape[2]};
+            throw std::runtime_error("bmm only supports 2D and 3D tensors");
+        };
+
+        auto [batch_a, m, n] = unpack(A);
+        auto [batch_b, n_b, p] = unpack(B);
+
+        if (n != n_b)
+            throw std::runtime_error("bmm shapes do not align");
+        if (batch_a != batch_b && batch_a != 1 && batch_b != 1)
+            throw std::runtime_error("bmm batch sizes do not match");
+
+        size_t batch = std::max(batch_a, batch_b);
+        size_t stride_a = batch_a == 1 ? 0 : m * n;
+        size_t stride_b = batch_b == 1 ? 0 : n * p;
+
+        std::vector<T> out_data(batch * m * p, 0.0);
+        raw_bmm(A->data.data(), B->data.data(), out_data.data(), batch, m, n, p,
+                stride_a, stride_b, m * p);
+
+        auto out = std::make_shared<Tensor<T>>(
+                typename Tensor<T>::Shape{batch, m, p},
+                out_data,
+                A->requires_grad || B->requires_grad,
+                std::vector<TensorS<T>>{A, B},
+                "BmmBackward"
+        );
+
+        out->grad_fn = [A, B, out = out.get(), batch, batch_a, batch_b, m, n, p, stride_a, stride_b]() {
+            // Size of one stacked channel of the output and of the operands
+            const size_t C = out->channels(), size = batch * m * p, size_a = A->data.size(), size_b = B->data.size();
+            if (A->requires_grad) {
+                auto BT = batch_transpose(B->data, batch_b, n, p);
+                size_t stride_bt = batch_b == 1 ? 0 : p * n;
+                auto &A_grad = A->grad_sink();
+                auto &A_hess = A->hess_sink();
+                if (stride_bt == 0 && stride_a != 0) {
+                    // B is shared: the batches of every channel are C * batch rows blocks, one GEMM
+                    raw_bmm(out->grad.data(), BT.data(), A_grad.data(), C * batch, m, p, n, m * p, 0, stride_a, T(1));
+                    for (auto &x: BT) x *= x;
+                    raw_bmm(out->hess.data(), BT.data(), A_hess.data(), C * batch, m, p, n, m * p, 0, stride_a, T(1));
+                } else {
+                    auto BT2 = BT;
+                    for (auto &x: BT2) x *= x;
+                    for (size_t c = 0; c < C; ++c) {
+                        raw_bmm(out->grad.data() + c * size, BT.data(), A_grad.data() + c * size_a, batch, m, p, n,
+                                m * p, stride_bt, stride_a, T(1));
+                        raw_bmm(out->hess.data() + c * size, BT2.data(), A_hess.data() + c * size_a, batch, m, p, n,
+                                m * p, stride_bt, stride_a, T(1));
+                    }
+                }
+            }
+
+            if (B->requires_grad) {
+                auto AT = batch_transpose(A->data, batch_a, m, n);
+                auto AT2 = AT;
+                for (auto &x: AT2) x *= x;
+                size_t stride_at = batch_a == 1 ? 0 : n * m;
+                auto &B_grad = B->grad_sink();
+                auto &B_hess = B->hess_sink();
+                for (size_t c = 0; c < C; ++c) {
+                    raw_bmm(AT.data(), out->grad.data() + c * size, B_grad.data() + c * size_b, batch, n, m, p,
+                            stride_at, m * p, stride_b, T(1));
+                    raw_bmm(AT2.data(), out->hess.data() + c * size, B_hess.data() + c * size_b, batch, n, m, p,
+                            stride_at, m * p, stride_b, T(1));
+                }
             }
         };
 
@@ -0,0 +1,406 @@
+#ifndef REDUCTIONS_HPP
+#define REDUCTIONS_HPP
+
+#include "core/tensor_core.hpp"
+#include "parallel/thread_pool.hpp"
+#include <array>
+#include <cmath>
+#include <stdexcept>
+
+namespace tensor::ops {
+
+    /// Number of elements reduced by each independent block of a reduction
+    inline constexpr size_t REDUCTION_BLOCK = 4096;
+
+    /**
+     * @brief Sums f(x[i]) for i in [0, n) with pairwise summation.
+     *
+     * The range is split recursively in halves; leaves of at most 64 elements are
+     * summed with 8 independent accumulators so the compiler can vectorize them.
+     * The rounding error grows as O(log n) instead of O(n) for a serial loop.
+     *
+     * @tparam T Numeric type
+     * @param x Pointer to the first element
+     * @param n Number of elements
+     * @param f Element-wise transformation applied before summing
+     * @return The sum
+     */
+    template<Numeric T, typename F>
+    T pairwise_sum(const T *x, size_t n, F f)
+    {
+        if (n <= 64) {
+            T acc[8] = {};
+            size_t i = 0;
+            for (; i + 8 <= n; i += 8) {
+                for (size_t k = 0; k < 8; ++k) acc[k] += f(x[i + k]);
+            }
+            T s = ((acc[0] + acc[1]) + (acc[2] + acc[3])) + ((acc[4] + acc[5]) + (acc[6] + acc[7]));
+            for (; i < n; ++i) s += f(x[i]);
+            return s;
+        }
+        // Keeps the left half a multiple of 8 so that leaves stay aligned
+        size_t half = (n / 2) & ~size_t(7);
+        return pairwise_sum(x, half, f) + pairwise_sum(x + half, n - half, f);
+    }
+
+    template<Numeric T>
+    T pairwise_sum(const T *x, size_t n)
+    {
+        return pairwise_sum(x, n, [](T v) { return v; });
+    }
+
+    /**
+     * @brief Sums f(x[i]) for i in [0, n) over fixed-size blocks.
+     *
+     * Every block of REDUCTION_BLOCK elements is reduced independently and the
+     * partial sums are combined pairwise. Blocks are reduced concurrently on
+     * the thread pool, but the block layout only depends on n, so the result
+     * is bit-wise reproducible for any number of threads.
+     */
+    template<Numeric T, typename F>
+    T blocked_sum(const T *x, size_t n, F f)
+    {
+        const size_t n_blocks = (n + REDUCTION_BLOCK - 1) / REDUCTION_BLOCK;
+        if (n_blocks <= 1) return pairwise_sum(x, n, f);
+
+        std::vector<T> partial(n_blocks);
+        parallel::pool().run_tasks(n_blocks, [&](size_t b) {
+            const size_t begin = b * REDUCTION_BLOCK;
+            partial[b] = pairwise_sum(x + begin, std::min(REDUCTION_BLOCK, n - begin), f);
+        });
+        return pairwise_sum(partial.data(), n_blocks);
+    }
+
+    /**
+     * @brief Sums len rows of size inner with pairwise summation.
+     *
+     * Computes out[i] = sum_k f(x[k * inner + i]); rows are combined pairwise and the
+     * inner loops run over contiguous memory.
+     *
+     * @param scratch Temporary buffer of at least inner * (log2(len) + 1) elements
+     */
+    template<Numeric T, typename F>
+    void pairwise_sum_rows(const T *x, size_t len, size_t inner, T *out, T *scratch, F f)
+    {
+        if (len <= 8) {
+            for (size_t i = 0; i < inner; ++i) out[i] = f(x[i]);
+            for (size_t k = 1; k < len; ++k) {
+                for (size_t i = 0; i < inner; ++i) out[i] += f(x[k * inner + i]);
+            }
+            return;
+        }
+        const size_t half = len / 2;
+        pairwise_sum_rows(x, half, inner, out, scratch, f);
+        pairwise_sum_rows(x + half * inner, len - half, inner, scratch, scratch + inner, f);
+        for (size_t i = 0; i < inner; ++i) out[i] += scratch[i];
+    }
+
+    /**
+     * @brief Decomposes a shape around a reduction dimension.
+     *
+     * @return {outer, len, inner} such that the tensor is viewed as (outer, len, inner)
+     * @throws std::runtime_error if dim is out of range
+     */
+    inline std::array<size_t, 3> reduction_extents(const std::vector<size_t> &shape, size_t dim)
+    {
+        if (dim >= shape.size()) throw std::runtime_error("Reduction dimension out of range");
+        size_t outer = 1, inner = 1;
+        for (size_t d = 0; d < dim; ++d) outer *= shape[d];
+        for (size_t d = dim + 1; d < shape.size(); ++d) inner *= shape[d];
+        return {outer, shape[dim], inner};
+    }
+
+    /**
+     * @brief Returns the shape of a tensor reduced along dim.
+     *
+     * @param keepdim if true the reduced dimension is kept with size 1
+     */
+    inline std::vector<size_t> reduced_shape(const std::vector<size_t> &shape, size_t dim, bool keepdim)
+    {
+        std::vector<size_t> out(shape);
+        if (keepdim) out[dim] = 1;
+        else out.erase(out.begin() + dim);
+        if (out.empty()) out.push_back(1);
+        return out;
+    }
+
+    /**
+     * @brief Reduces a tensor viewed as (outer, len, inner) along its middle axis.
+     *
+     * Computes out[o, i] = sum_k f(a[o, k, i]).
+     */
+    template<Numeric T, typename F>
+    std::vector<T> sum_along(const std::vector<T> &a, size_t outer, size_t len, size_t inner, F f)
+    {
+        std::vector<T> out(outer * inner);
+        if (inner == 1) {
+            parallel::parallel_for(0, outer, [&](size_t lo, size_t hi) {
+                for (size_t o = lo; o < hi; ++o) out[o] = blocked_sum(a.data() + o * len, len, f);
+            }, parallel::row_grain(len));
+            return out;
+        }
+        size_t depth = 1;
+        for (size_t l = len; l > 8; l = (l + 1) / 2) ++depth;
+        parallel::parallel_for(0, outer, [&](size_t lo, size_t hi) {
+            std::vector<T> scratch(inner * depth);
+            for (size_t o = lo; o < hi; ++o) {
+                pairwise_sum_rows(a.data() + o * len * inner, len, inner, out.data() + o * inner, scratch.data(), f);
+            }
+        }, parallel::row_grain(len * inner));
+        return out;
+    }
+
+    /**
+     * Builds a scaled sum reduction node over the (outer, len, inner) view of a.
+     */
+    template<Numeric T>
+    TensorS<T> scaled_sum(TensorS<T> a, size_t outer, size_t len, size_t inner, T scale,
+                          typename Tensor<T>::Shape shape, std::string name)
+    {
+        auto out_data = sum_along(a->data, outer, len, inner, [](T v) { return v; });
+        if (scale != T(1)) for (auto &v: out_data) v *= scale;
+
+        auto out = std::make_shared<Tensor<T>>(
+                std::move(shape),
+                out_data,
+                a->requires_grad,
+                std::vector<TensorS<T>>{a},
+                std::move(name)
+        );
+
+        out->grad_fn = [a, out = out.get(), outer, len, inner, scale]() {
+            if (!a->requires_grad) return;
+            const T scale2 = scale * scale;
+            auto &a_grad = a->grad_sink();
+            auto &a_hess = a->hess_sink();
+            // Rows of the stacked channels, every channel being (outer, len, inner)
+            parallel::parallel_for(0, out->channels() * outer * len, [&](size_t lo, size_t hi) {
+                for (size_t row = lo; row < hi; ++row) {
+                    const size_t o = row / len;
+                    const size_t base = row * inner;
+                    for (size_t i = 0; i < inner; ++i) {
+                        a_grad[base + i] += scale * out->grad[o * inner + i];
+                        a_hess[base + i] += scale2 * out->hess[o * inner + i];
+                    }
+                }
+            }, parallel::row_grain(inner));
+        };
+
+        return out;
+    }
+
+    /**
+     * Computes the sum of all elements in a tensor.
+     *
+     * @tparam T Numeric type
+     * @param a Input tensor
+     * @return A scalar tensor containing the sum of all elements of a
+     */
+    template <Numeric T>
+    TensorS<T> sum(TensorS<T> a) {
+        return scaled_sum(a, 1, a->data.size(), 1, T(1), {1}, "SumBackward");
+    }
+
+    /**
+     * Computes the sum of a tensor along a dimension.
+     *
+     * @tparam T Numeric type
+     * @param a Input tensor
+     * @param dim Dimension to reduce
+     * @param keepdim Whether the reduced dimension is kept with size 1
+     * @return Output tensor
+     */
+    template <Numeric T>
+    TensorS<T> sum(TensorS<T> a, size_t dim, bool keepdim = false) {
+        auto [outer, len, inner] = reduction_extents(a->shape, dim);
+        return scaled_sum(a, outer, len, inner, T(1), reduced_shape(a->shape, dim, keepdim), "SumBackward");
+    }
+
+    /**
+     * Computes the mean of the elements in a tensor.
+     *
+     * @tparam T Numeric type
+     * @param a Input tensor
+     * @return A scalar tensor containing the mean
+     */
+    template <Numeric T>
+    TensorS<T> mean(TensorS<T> a) {
+        const size_t n = a->data.size();
+        return scaled_sum(a, 1, n, 1, T(1) / static_cast<T>(n), {1}, "MeanBackward");
+    }
+
+    /**
+     * Computes the mean of a tensor along a dimension.
+     *
+     * @tparam T Numeric type
+     * @param a Input tensor
+     * @param dim Dimension to reduce
+     * @param keepdim Whether the reduced dimension is kept with size 1
+     * @return Output tensor
+     */
+    template <Numeric T>
+    TensorS<T> mean(TensorS<T> a, size_t dim, bool keepdim = false) {
+        auto [outer, len, inner] = reduction_extents(a->shape, dim);
+        return scaled_sum(a, outer, len, inner, T(1) / static_cast<T>(len),
+                          reduced_shape(a->shape, dim, keepdim), "MeanBackward");
+    }
+
+    /**
+     * Builds a max reduction node over the (outer, len, inner) view of a.
+     *
+     * The gradient flows to the first maximal element of each reduced slice.
+     */
+    template<Numeric T>
+    TensorS<T> max_along(TensorS<T> a, size_t outer, size_t len, size_t inner, typename Tensor<T>::Shape shape)
+    {
+        std::vector<T> out_data(outer * inner);
+        std::vector<size_t> argmax(outer * inner);
+
+        parallel::parallel_for(0, outer, [&](size_t lo, size_t hi) {
+            for (size_t o = lo; o < hi; ++o) {
+                const size_t base = o * len * inner;
+                for (size_t i = 0; i < inner; ++i) {
+                    out_data[o * inner + i] = a->data[base + i];
+                    argmax[o * inner + i] = base + i;
+                }
+                for (size_t k = 1; k < len; ++k) {
+                    for (size_t i = 0; i < inner; ++i) {
+                        const size_t idx = base + k * inner + i;
+                        if (a->data[idx] > out_data[o * inner + i]) {
+                            out_data[o * inner + i] = a->data[idx];
+                            argmax[o * inner + i] = idx;
+                        }
+                    }
+                }
+            }
+        }, parallel::row_grain(len * inner));
+
+        auto out = std::make_shared<Tensor<T>>(
+                std::move(shape),
+                out_data,
+                a->requires_grad,
+                std::vector<TensorS<T>>{a},
+                "MaxBackward"
+        );
+
+        out->grad_fn = [a, out = out.get(), argmax = std::move(argmax)]() {
+            if (!a->requires_grad) return;
+            auto &a_grad = a->grad_sink();
+            auto &a_hess = a->hess_sink();
+            const size_t C = out->channels(), n = a->data.size(), m = argmax.size();
+            for (size_t c = 0; c < C; ++c) {
+                for (size_t j = 0; j < m; ++j) {
+                    a_grad[c * n + argmax[j]] += out->grad[c * m + j];
+                    a_hess[c * n + argmax[j]] += out->hess[c * m + j];
+                }
+            }
+        };
+
+        return out;
+    }
+
+    /**
+     * Computes the maximum of all elements in a tensor.
+     *
+     * @tparam T Numeric type
+     * @param a Input tensor
+     * @return A scalar tensor containing the maximum
+     */
+    template <Numeric T>
+    TensorS<T> max(TensorS<T> a) {
+        return max_along(a, 1, a->data.size(), 1, {1});
+    }
+
+    /**
+     * Computes the maximum of a tensor along a dimension.
+     *
+     * @tparam T Numeric type
+     * @param a Input tensor
+     * @param dim Dimension to reduce
+     * @param keepdim Whether the reduced dimension is kept with size 1
+     * @return Output tensor
+     */
+    template <Numeric T>
+    TensorS<T> max(TensorS<T> a, size_t dim, bool keepdim = false) {
+        auto [outer, len, inner] = reduction_extents(a->shape, dim);
+        return max_along(a, outer, len, inner, reduced_shape(a->shape, dim, keepdim));
+    }
+
+    /**
+     * Builds a Euclidean norm reduction node over the (outer, len, inner) view of a.
+     *
+     * With n = ||x||, the derivatives are dn/dx_k = x_k / n and
+     * d^2n/dx_k^2 = 1 / n - x_k^2 / n^3. They are set to zero where n = 0.
+     */
+    template<Numeric T>
+    TensorS<T> norm_along(TensorS<T> a, size_t outer, size_t len, size_t inner, typename Tensor<T>::Shape shape)
+    {
+        auto out_data = sum_along(a->data, outer, len, inner, [](T v) { return v * v; });
+        for (auto &v: out_data) v = math::sqrt(v);
+
+        auto out = std::make_shared<Tensor<T>>(
+                std::move(shape),
+                out_data,
+                a->requires_grad,
+                std::vector<TensorS<T>>{a},
+                "NormBackward"
+        );
+
+        out->grad_fn = [a, out = out.get(), outer, len, inner]() {
+            if (!a->requires_grad) return;
+            auto &a_grad = a->grad_sink();
+            auto &a_hess = a->hess_sink();
+            const size_t C = out->channels(), size = a->data.size(), out_size = out->data.size();
+            parallel::parallel_for(0, outer * len, [&](size_t lo, size_t hi) {
+                for (size_t row = lo; row < hi; ++row) {
+                    const size_t o = row / len;
+                    const size_t base = row * inner;
+                    for (size_t i = 0; i < inner; ++i) {
+                        const T n = out->data[o * inner + i];
+                        if (n == T(0)) continue;
+                        const T x = a->data[base + i];
+                        const T dy = x / n;
+                        const T d2y = (T(1) - dy * dy) / n;
+                        for (size_t c = 0; c < C; ++c) {
+                            const T g = out->grad[c * out_size + o * inner + i];
+                            a_grad[c * size + base + i] += g * dy;
+                            a_hess[c * size + base + i] += out->hess[c * out_size + o * inner + i] * dy * dy + g * d2y;
+                        }
+                    }
+                }
+            }, parallel::row_grain(inner));
+        };
+
+        return out;
+    }
+
+    /**
+     * Computes the Euclidean norm of all elements in a tensor.
+     *
+     * @tparam T Numeric type
+     * @param a Input tensor
+     * @return A scalar tensor containing the norm
+     */
+    template <Numeric T>
+    TensorS<T> norm(TensorS<T> a) {
+        return norm_along(a, 1, a->data.size(), 1, {1});
+    }
+
+    /**
+     * Computes the Euclidean norm of a tensor along a dimension.
+     *
+     * @tparam T Numeric type
+     * @param a Input tensor
+     * @param dim Dimension to reduce
+     * @param keepdim Whether the reduced dimension is kept with size 1
+     * @return Output tensor
+     */
+    template <Numeric T>
+    TensorS<T> norm(TensorS<T> a, size_t dim, bool keepdim = false) {
+        auto [outer, len, inner] = reduction_extents(a->shape, dim);
+        return norm_along(a, outer, len, inner, reduced_shape(a->shape, dim, keepdim));
+    }
+
+}
+
+#endif
@@ -0,0 +1,131 @@
+#ifndef SPMM_HPP
+#define SPMM_HPP
+
+#include "core/tensor_core.hpp"
+#include "core/sparse.hpp"
+#include "parallel/thread_pool.hpp"
+#include <memory>
+
+/**
+ * @brief Accumulates a block of rows of a CSR matrix times a dense matrix.
+ *
+ * For every row r in [r_begin, r_end) computes y[r, :] += sum_k f(v_k) * x[c_k, :],
+ * where v_k = values[perm ? perm[k] : k] and f is the identity or the square.
+ * Rows are independent, so disjoint row blocks can be processed concurrently.
+ *
+ * @tparam T Numeric type
+ * @param row_ptr CSR row offsets
+ * @param col_idx CSR column indices
+ * @param values Non-zero values
+ * @param perm Optional permutation of the values (used for the transpose)
+ * @param square If true the squared values are used
+ * @param x Dense input matrix with k columns
+ * @param y Dense output matrix with k columns
+ * @param k Number of columns of x and y
+ */
+template<Numeric T>
+void raw_csr_rows(const std::vector<size_t> &row_ptr, const std::vector<size_t> &col_idx,
+                  const T *values, const size_t *perm, bool square,
+                  const T *x, T *y, size_t k, size_t r_begin, size_t r_end)
+{
+    for (size_t r = r_begin; r < r_end; ++r) {
+        T *yr = y + r * k;
+        for (size_t nz = row_ptr[r]; nz < row_ptr[r + 1]; ++nz) {
+            T v = values[perm ? perm[nz] : nz];
+            if (square) v *= v;
+            const T *xc = x + col_idx[nz] * k;
+            for (size_t j = 0; j < k; ++j) yr[j] += v * xc[j];
+        }
+    }
+}
+
+namespace tensor::ops {
+
+    /**
+     * Computes the product of a sparse CSR matrix and a dense tensor.
+     *
+     * A has shape (R, C) and X has shape (C, K) or (C); the output has shape (R, K) or (R).
+     * Gradients and diagonal Hessians are propagated to X (through A^T and its
+     * element-wise square) and, if they require it, to the non-zero values of A.
+     *
+     * @tparam T Numeric type
+     * @param A Sparse matrix
+     * @param X Dense input tensor
+     * @return Output tensor
+     * @throws std::runtime_error if the shapes do not align
+     */
+    template<Numeric T>
+    TensorS<T> spmm(SparseS<T> A, TensorS<T> X) {
+        if (X->shape.empty() || X->shape.size() > 2)
+            throw std::runtime_error("spmm only supports 1D and 2D dense tensors");
+        if (X->shape[0] != A->cols)
+            throw std::runtime_error("spmm shapes do not align");
+
+        const size_t rows = A->rows;
+        const size_t k = X->shape.size() == 2 ? X->shape[1] : 1;
+
+        typename Tensor<T>::Shape shape{rows};
+        if (X->shape.size() == 2) shape.push_back(k);
+
+        std::vector<T> out_data(rows * k, T(0));
+        const size_t grain = parallel::row_grain(k * std::max<size_t>(1, A->nnz() / std::max<size_t>(1, rows)));
+        parallel::parallel_for(0, rows, [&](size_t lo, size_t hi) {
+            raw_csr_rows(A->row_ptr, A->col_idx, A->values->data.data(), (const size_t *) nullptr, false,
+                         X->data.data(), out_data.data(), k, lo, hi);
+        }, grain);
+
+        auto values = A->values;
+        auto out = std::make_shared<Tensor<T>>(
+                shape,
+                out_data,
+                values->requires_grad || X->requires_grad,
+                std::vector<TensorS<T>>{values, X},
+                "SpMMBackward"
+        );
+
+        out->grad_fn = [A, values, X, out = out.get(), rows, k, grain]() {
+            const size_t C = out->channels(), size = rows * k, size_x = A->cols * k, nnz = A->nnz();
+            if (X->requires_grad) {
+                auto &X_grad = X->grad_sink();
+                auto &X_hess = X->hess_sink();
+                // Rows of A^T are the rows of X: disjoint writes per row block, for every stacked channel
+                parallel::parallel_for(0, A->cols, [&](size_t lo, size_t hi) {
+                    for (size_t c = 0; c < C; ++c) {
+                        raw_csr_rows(A->t_row_ptr, A->t_col_idx, values->data.data(), A->t_perm.data(), false,
+                                     out->grad.data() + c * size, X_grad.data() + c * size_x, k, lo, hi);
+                        raw_csr_rows(A->t_row_ptr, A->t_col_idx, values->data.data(), A->t_perm.data(), true,
+                                     out->hess.data() + c * size, X_hess.data() + c * size_x, k, lo, hi);
+                    }
+                }, grain);
+            }
+
+            if (values->requires_grad) {
+                auto &values_grad = values->grad_sink();
+                auto &values_hess = values->hess_sink();
+                parallel::parallel_for(0, rows, [&](size_t lo, size_t hi) {
+                    for (size_t r = lo; r < hi; ++r) {
+                        for (size_t nz = A->row_ptr[r]; nz < A->row_ptr[r + 1]; ++nz) {
+                            const T *xc = X->data.data() + A->col_idx[nz] * k;
+                            for (size_t c = 0; c < C; ++c) {
+                                const T *g = out->grad.data() + c * size + r * k;
+                                const T *h = out->hess.data() + c * size + r * k;
+                                T dg = 0, dh = 0;
+                                for (size_t j = 0; j < k; ++j) {
+                                    dg += g[j] * xc[j];
+                                    dh += h[j] * xc[j] * xc[j];
+                                }
+                                values_grad[c * nnz + nz] += dg;
+                                values_hess[c * nnz + nz] += dh;
+                            }
+                        }
+                    }
+                }, grain);
+            }
+        };
+
+        return out;
+    }
+
+}
+
+#endif
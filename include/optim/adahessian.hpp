@@ -0,0 +1,138 @@
+#ifndef ADAHESSIAN_HPP
+#define ADAHESSIAN_HPP
+
+#include "optim/optim.hpp"
+#include <algorithm>
+#include <stdexcept>
+
+namespace tensor::optim {
+
+    /**
+     * @brief AdaHessian optimizer: Adam preconditioned by the diagonal of the Hessian.
+     *
+     * The second moment of Adam is replaced by an exponential moving average
+     * (temporal averaging) of the squared Hessian diagonal, which backward
+     * already propagates into the hess of every parameter. Optionally the
+     * diagonal is also averaged in absolute value over consecutive blocks of
+     * block_size elements of every parameter (spatial averaging), which
+     * smooths the estimate.
+     *
+     *     m = beta1 * m + (1 - beta1) * g
+     *     v = beta2 * v + (1 - beta2) * D^2
+     *     p -= lr * (m_hat / (sqrt(v_hat)^hessian_power + eps) + weight_decay * p)
+     *
+     * m_hat and v_hat being the bias-corrected moments. With hessian_power = 1
+     * the step approaches the Newton step g / |D| on separable problems.
+     *
+     * References:
+     * \link https://arxiv.org/abs/2006.00719
+     *
+     * @tparam T Numeric type
+     */
+    template<Numeric T>
+    class AdaHessian : public Optimizer<T> {
+    public:
+
+        /**
+         * @param tensors Parameters to optimize
+         * @param learning_rate Learning rate
+         * @param beta1 First moment decay
+         * @param beta2 Hessian moment decay
+         * @param eps Small epsilon to prevent division by zero
+         * @param weight_decay Decoupled weight decay
+         * @param hessian_power Exponent of the preconditioner, in (0, 1]
+         * @param block_size Number of consecutive elements sharing the averaged diagonal (1 disables it)
+         * @throws std::runtime_error if block_size is zero
+         */
+        AdaHessian(const std::vector<TensorS<T>> &tensors, T learning_rate, T beta1, T beta2, T eps,
+                   T weight_decay, T hessian_power = 1, size_t block_size = 1)
+                : params(tensors), lr(learning_rate), beta1(beta1), beta2(beta2), eps(eps),
+                  weight_decay(weight_decay), hessian_power(hessian_power), block_size(block_size)
+        {
+            if (block_size == 0) throw std::runtime_error("AdaHessian: block_size must be positive");
+            for (const auto &p: params) {
+                m.emplace_back(p->data.size(), T(0));
+                v.emplace_back(p->data.size(), T(0));
+            }
+        }
+
+        void step() override {
+            beta1_t *= beta1;
+            beta2_t *= beta2;
+            const T bias1 = T(1) - beta1_t, bias2 = T(1) - beta2_t;
+
+            std::vector<T> diag;
+            for (size_t k = 0; k < params.size(); ++k) {
+                auto &p = params[k];
+                averaged_diagonal(p->hess, diag);
+                for (size_t i = 0; i < p->data.size(); ++i) {
+                    m[k][i] = beta1 * m[k][i] + (T(1) - beta1) * p->grad[i];
+                    v[k][i] = beta2 * v[k][i] + (T(1) - beta2) * diag[i] * diag[i];
+                    T denom = tensor::math::sqrt(v[k][i] / bias2);
+                    if (hessian_power != T(1) && denom > T(0))
+                        denom = tensor::math::exp(hessian_power * tensor::math::log(denom));
+                    p->data[i] -= lr * (m[k][i] / bias1 / (denom + eps) + weight_decay * p->data[i]);
+                }
+            }
+        }
+
+        void zero_grad() override {
+            for (auto &p: this->params) {
+                p->zero_grad();
+            }
+        }
+
+    private:
+
+        /**
+         * @brief Hessian diagonal, averaged in absolute value over blocks of block_size elements.
+         */
+        void averaged_diagonal(const std::vector<T> &hess, std::vector<T> &out) const {
+            if (block_size == 1) {
+                out = hess;
+                return;
+            }
+            out.resize(hess.size());
+            for (size_t lo = 0; lo < hess.size(); lo += block_size) {
+                const size_t hi = std::min(hess.size(), lo + block_size);
+                T mean = 0;
+                for (size_t i = lo; i < hi; ++i) mean += tensor::math::abs(hess[i]);
+                mean /= T(hi - lo);
+                std::fill(out.begin() + lo, out.begin() + hi, mean);
+            }
+        }
+
+        /// Parameters being optimized
+        std::vector<TensorS<T>> params;
+
+        /// First moments and moving averages of the squared Hessian diagonal, one per parameter
+        std::vector<std::vector<T>> m, v;
+
+        /// Learning rate
+        T lr;
+
+        /// First moment decay
+        T beta1;
+
+        /// Hessian moment decay
+        T beta2;
+
+        /// Small epsilon to prevent division by zero
+        T eps;
+
+        /// Decoupled weight decay
+        T weight_decay;
+
+        /// Exponent of the preconditioner
+        T hessian_power;
+
+        /// Size of the blocks of the spatial averaging
+        size_t block_size;
+
+        /// beta1^t and beta2^t at the current step
+        T beta1_t = 1, beta2_t = 1;
+    };
+
+}
+
+#endif
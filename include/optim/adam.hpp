@@ -2,6 +2,8 @@
 #define ADAM_HPP
 
 #include "optim/optim.hpp"
+#include "parallel/thread_pool.hpp"
+#include <algorithm>
 #include <cmath>
 
 namespace tensor::optim {
@@ -120,5 +122,111 @@ namespace tensor::optim {
         int step_count = 0;
     };
 
+    /**
+     * @brief Adam with decoupled weight decay (AdamW), updating all parameters in one fused kernel.
+     *
+     * The moments of all parameters are stored in two contiguous flat buffers,
+     * and the parameters are addressed as consecutive segments of the same flat
+     * index space, so a step is a single element-wise loop over the whole model
+     * (split across the threads of the pool for large models) instead of one
+     * loop per tensor. Every parameter owns its data, so only the moments are
+     * flat: the kernel updates each parameter in place, through its segment.
+     * The bias corrections are kept as running products instead of being
+     * recomputed with pow at every step.
+     *
+     * The weight decay is decoupled from the gradient,
+     *
+     *     p -= lr * weight_decay * p + step_size * m / (sqrt(v) + eps),
+     *
+     * so with weight_decay = 0 the update is the one of Adam.
+     *
+     * References:
+     * \link https://arxiv.org/abs/1711.05101
+     *
+     * @tparam T Numeric type
+     */
+    template<Numeric T>
+    class FusedAdam : public Optimizer<T> {
+    public:
+
+        FusedAdam(const std::vector<TensorS<T>> &tensors, T learning_rate, T beta1, T beta2, T eps, T weight_decay)
+                : params(tensors), lr(learning_rate), beta1(beta1), beta2(beta2), eps(eps),
+                  weight_decay(weight_decay)
+        {
+            offsets.reserve(params.size() + 1);
+            offsets.push_back(0);
+            for (const auto &p: params) offsets.push_back(offsets.back() + p->data.size());
+            m.assign(size(), T(0));
+            v.assign(size(), T(0));
+        }
+
+        /**
+         * @return the total number of optimized elements
+         */
+        size_t size() const {
+            return offsets.back();
+        }
+
+        void step() override {
+            beta1_t *= beta1;
+            beta2_t *= beta2;
+            const T step_size = lr * tensor::math::sqrt(T(1) - beta2_t) / (T(1) - beta1_t);
+            const T decay = lr * weight_decay;
+            const T b1 = beta1, b2 = beta2, e = eps;
+
+            // Constants captured by value, so that the loads do not block vectorization
+            parallel::parallel_for(0, size(), [&, step_size, decay, b1, b2, e](size_t lo, size_t hi) {
+                // First segment overlapping [lo, hi)
+                size_t t = std::upper_bound(offsets.begin(), offsets.end(), lo) - offsets.begin() - 1;
+                for (; t < params.size() && offsets[t] < hi; ++t) {
+                    const size_t begin = std::max(lo, offsets[t]), n = std::min(hi, offsets[t + 1]) - begin;
+                    T *__restrict p = params[t]->data.data() + (begin - offsets[t]);
+                    const T *__restrict g = params[t]->grad.data() + (begin - offsets[t]);
+                    T *__restrict m1 = m.data() + begin;
+                    T *__restrict m2 = v.data() + begin;
+                    for (size_t i = 0; i < n; ++i) {
+                        m1[i] = b1 * m1[i] + (T(1) - b1) * g[i];
+                        m2[i] = b2 * m2[i] + (T(1) - b2) * g[i] * g[i];
+                        p[i] -= decay * p[i] + step_size * m1[i] / (tensor::math::sqrt(m2[i]) + e);
+                    }
+                }
+            });
+        }
+
+        void zero_grad() override {
+            for (auto &p: this->params) {
+                p->zero_grad();
+            }
+        }
+
+    private:
+        /// Parameters being optimized
+        std::vector<TensorS<T>> params;
+
+        /// offsets[i]: position of parameter i in the flat index space
+        std::vector<size_t> offsets;
+
+        /// First and second moments
+        std::vector<T> m, v;
+
+        /// Learning rate
+        T lr;
+
+        /// First moment decay
+        T beta1;
+
+        /// Second moment decay
+        T beta2;
+
+        /// Small epsilon to prevent division by zero
+        T eps;
+
+        /// Decoupled weight decay
+        T weight_decay;
+
+        /// beta1^t and beta2^t at the current step
+        T beta1_t = 1, beta2_t = 1;
+    };
+
 }
 #endif
\ No newline at end of file
@@ -0,0 +1,393 @@
+#ifndef LBFGS_HPP
+#define LBFGS_HPP
+
+#include "optim/optim.hpp"
+#include <algorithm>
+#include <deque>
+#include <functional>
+#include <stdexcept>
+
+namespace tensor::optim {
+
+    /**
+     * @brief Limited-memory BFGS optimizer.
+     *
+     * Quasi-Newton method: the inverse Hessian is approximated from the last
+     * history_size parameter and gradient differences by the two-loop recursion,
+     * which works on the parameters and the gradients flattened into single
+     * vectors. The step along the resulting direction is chosen by a line
+     * search satisfying the strong Wolfe conditions, or is the fixed learning
+     * rate if the line search is disabled.
+     *
+     * Every call of step(closure) runs up to max_iter iterations and may
+     * evaluate the loss several times: the closure must compute the loss at the
+     * current parameters, backpropagate it and return its value. The gradients
+     * are zeroed by the optimizer before every evaluation. The history is kept
+     * across calls, so training can alternate calls to step with logging.
+     * The last evaluation of the closure may be a trial point rejected by the
+     * line search: the returned loss is the one at the accepted parameters.
+     *
+     * Typical use in PINN training is to refine the solution found by Adam.
+     *
+     * References:
+     * \link https://en.wikipedia.org/wiki/Limited-memory_BFGS
+     * \link Nocedal, J., & Wright, S. J. (2006). Numerical Optimization, Algorithms 3.5, 3.6 and 7.4
+     *
+     * @tparam T Numeric type
+     */
+    template<Numeric T>
+    class LBFGS : public Optimizer<T> {
+    public:
+
+        using Closure = std::function<T()>;
+
+        /**
+         * @param params Parameters to optimize
+         * @param learning_rate Initial step of the line search, or fixed step without it
+         * @param history_size Number of stored correction pairs
+         * @param max_iter Maximum number of iterations per call of step
+         * @param line_search If true the step satisfies the strong Wolfe conditions
+         * @param tolerance_grad Stops when the largest gradient component is below it
+         * @param tolerance_change Stops when the change of the loss or of the parameters is below it
+         */
+        LBFGS(const std::vector<TensorS<T>> &params, T learning_rate = 1, size_t history_size = 10,
+              size_t max_iter = 20, bool line_search = true, T tolerance_grad = 1e-7, T tolerance_change = 1e-9)
+                : params(params), lr(learning_rate), history_size(history_size), max_iter(max_iter),
+                  line_search(line_search), tolerance_grad(tolerance_grad), tolerance_change(tolerance_change) {}
+
+        /**
+         * @brief Not available: L-BFGS needs to reevaluate the loss, use step(closure).
+         *
+         * @throws std::runtime_error
+         */
+        void step() override {
+            throw std::runtime_error("LBFGS requires a closure: use step(closure)");
+        }
+
+        /**
+         * @brief Performs up to max_iter iterations.
+         *
+         * @param closure Computes the loss, backpropagates it and returns its value
+         * @return the loss at the parameters reached by the step
+         */
+        T step(const Closure &closure) {
+            T loss = evaluate(closure);
+            std::vector<T> g = flat_grad();
+            if (max_abs(g) <= tolerance_grad) return loss;
+
+            for (size_t iter = 0; iter < max_iter; ++iter) {
+                ++n_iter;
+
+                // Search direction from the two-loop recursion
+                if (n_iter == 1) {
+                    d = scaled(g, T(-1));
+                    h_diag = 1;
+                } else {
+                    std::vector<T> y(g.size()), s(g.size());
+                    for (size_t i = 0; i < g.size(); ++i) {
+                        y[i] = g[i] - g_prev[i];
+                        s[i] = t * d[i];
+                    }
+                    const T ys = dot(y, s);
+                    if (ys > T(1e-10)) {
+                        if (s_hist.size() == history_size) {
+                            s_hist.pop_front();
+                            y_hist.pop_front();
+                            rho.pop_front();
+                        }
+                        s_hist.push_back(std::move(s));
+                        rho.push_back(T(1) / ys);
+                        h_diag = ys / dot(y, y);
+                        y_hist.push_back(std::move(y));
+                    }
+                    d = direction(g);
+                }
+                g_prev = g;
+                const T prev_loss = loss;
+
+                // The first step is scaled by the gradient, until there is curvature information
+                t = n_iter == 1 ? std::min(T(1), T(1) / sum_abs(g)) * lr : lr;
+
+                const T gtd = dot(g, d);
+                if (gtd > -tolerance_change) break;
+
+                if (line_search) {
+                    auto x0 = flat_params();
+                    strong_wolfe(closure, x0, d, loss, g, gtd);
+                    set_params(x0, t, d);
+                } else {
+                    set_params(flat_params(), t, d);
+                    loss = evaluate(closure);
+                    g = flat_grad();
+                }
+
+                if (max_abs(g) <= tolerance_grad) break;
+                if (max_abs(d) * tensor::math::abs(t) <= tolerance_change) break;
+                if (tensor::math::abs(loss - prev_loss) < tolerance_change) break;
+            }
+            return loss;
+        }
+
+        void zero_grad() override {
+            for (auto &p: this->params) {
+                p->zero_grad();
+            }
+        }
+
+    private:
+
+        T evaluate(const Closure &closure) {
+            zero_grad();
+            return closure();
+        }
+
+        std::vector<T> flat_grad() const {
+            std::vector<T> g;
+            for (auto &p: params) g.insert(g.end(), p->grad.begin(), p->grad.end());
+            return g;
+        }
+
+        std::vector<T> flat_params() const {
+            std::vector<T> x;
+            for (auto &p: params) x.insert(x.end(), p->data.begin(), p->data.end());
+            return x;
+        }
+
+        /**
+         * @brief Sets the parameters to x + step * dir.
+         */
+        void set_params(const std::vector<T> &x, T step, const std::vector<T> &dir) {
+            size_t k = 0;
+            for (auto &p: params)
+                for (auto &e: p->data) {
+                    e = x[k] + step * dir[k];
+                    ++k;
+                }
+        }
+
+        static T dot(const std::vector<T> &a, const std::vector<T> &b) {
+            T out = 0;
+            for (size_t i = 0; i < a.size(); ++i) out += a[i] * b[i];
+            return out;
+        }
+
+        static T max_abs(const std::vector<T> &a) {
+            T out = 0;
+            for (auto &e: a) out = std::max(out, tensor::math::abs(e));
+            return out;
+        }
+
+        static T sum_abs(const std::vector<T> &a) {
+            T out = 0;
+            for (auto &e: a) out += tensor::math::abs(e);
+            return out;
+        }
+
+        static std::vector<T> scaled(const std::vector<T> &a, T c) {
+            std::vector<T> out(a.size());
+            for (size_t i = 0; i < a.size(); ++i) out[i] = c * a[i];
+            return out;
+        }
+
+        /**
+         * @brief Two-loop recursion: returns -H g, H being the inverse Hessian approximation.
+         */
+        std::vector<T> direction(const std::vector<T> &g) const {
+            auto q = scaled(g, T(-1));
+            const size_t m = s_hist.size();
+            std::vector<T> alpha(m);
+            for (size_t i = m; i-- > 0;) {
+                alpha[i] = rho[i] * dot(s_hist[i], q);
+                for (size_t j = 0; j < q.size(); ++j) q[j] -= alpha[i] * y_hist[i][j];
+            }
+            for (auto &e: q) e *= h_diag;
+            for (size_t i = 0; i < m; ++i) {
+                const T beta = rho[i] * dot(y_hist[i], q);
+                for (size_t j = 0; j < q.size(); ++j) q[j] += s_hist[i][j] * (alpha[i] - beta);
+            }
+            return q;
+        }
+
+        /**
+         * @brief Minimizer of the cubic interpolating (x1, f1, g1) and (x2, f2, g2), clamped to [lo, hi].
+         */
+        static T cubic_interpolate(T x1, T f1, T g1, T x2, T f2, T g2, T lo, T hi) {
+            const T d1 = g1 + g2 - T(3) * (f1 - f2) / (x1 - x2);
+            const T d2_square = d1 * d1 - g1 * g2;
+            if (d2_square < T(0)) return (lo + hi) / T(2);
+            const T d2 = tensor::math::sqrt(d2_square);
+            const T pos = x1 <= x2 ? x2 - (x2 - x1) * ((g2 + d2 - d1) / (g2 - g1 + T(2) * d2))
+                                   : x1 - (x1 - x2) * ((g1 + d2 - d1) / (g1 - g2 + T(2) * d2));
+            return std::min(std::max(pos, lo), hi);
+        }
+
+        static T cubic_interpolate(T x1, T f1, T g1, T x2, T f2, T g2) {
+            return cubic_interpolate(x1, f1, g1, x2, f2, g2, std::min(x1, x2), std::max(x1, x2));
+        }
+
+        /**
+         * @brief Line search along dir from x0 satisfying the strong Wolfe conditions.
+         *
+         * Brackets an interval containing acceptable steps, then shrinks it by
+         * cubic interpolation (zoom). On return t is the accepted step and loss and
+         * g are the loss and the gradient at x0 + t * dir.
+         */
+        void strong_wolfe(const Closure &closure, const std::vector<T> &x0, const std::vector<T> &dir,
+                          T &loss, std::vector<T> &g, T gtd) {
+            const T c1 = T(1e-4), c2 = T(0.9);
+            const size_t max_ls = 25;
+            const T d_norm = max_abs(dir);
+
+            auto evaluate_at = [&](T step, T &f, std::vector<T> &grad) {
+                set_params(x0, step, dir);
+                f = evaluate(closure);
+                grad = flat_grad();
+                return dot(grad, dir);
+            };
+
+            T f_new;
+            std::vector<T> g_new;
+            T gtd_new = evaluate_at(t, f_new, g_new);
+
+            T t_prev = 0, f_prev = loss, gtd_prev = gtd;
+            std::vector<T> g_prev_ls = g;
+
+            // Bracketing phase
+            std::vector<T> bracket, bracket_f, bracket_gtd;
+            std::vector<std::vector<T>> bracket_g;
+            bool done = false;
+            size_t ls_iter = 0;
+            auto bracket_last = [&]() {
+                bracket = {t_prev, t};
+                bracket_f = {f_prev, f_new};
+                bracket_g = {g_prev_ls, g_new};
+                bracket_gtd = {gtd_prev, gtd_new};
+            };
+            while (ls_iter < max_ls) {
+                if (f_new > loss + c1 * t * gtd || (ls_iter > 1 && f_new >= f_prev)) {
+                    bracket_last();
+                    break;
+                }
+                if (tensor::math::abs(gtd_new) <= -c2 * gtd) {
+                    bracket = {t};
+                    bracket_f = {f_new};
+                    bracket_g = {g_new};
+                    done = true;
+                    break;
+                }
+                if (gtd_new >= T(0)) {
+                    bracket_last();
+                    break;
+                }
+
+                // Extrapolation
+                const T min_step = t + T(0.01) * (t - t_prev), max_step = t * T(10);
+                const T next = cubic_interpolate(t_prev, f_prev, gtd_prev, t, f_new, gtd_new, min_step, max_step);
+                t_prev = t;
+                f_prev = f_new;
+                g_prev_ls = g_new;
+                gtd_prev = gtd_new;
+                t = next;
+                gtd_new = evaluate_at(t, f_new, g_new);
+                ++ls_iter;
+            }
+            if (ls_iter == max_ls) {
+                bracket = {T(0), t};
+                bracket_f = {loss, f_new};
+                bracket_g = {g, g_new};
+                bracket_gtd = {gtd, gtd_new};
+            }
+
+            // Zoom phase
+            bool insufficient_progress = false;
+            size_t low = bracket_f.front() <= bracket_f.back() ? 0 : 1, high = 1 - low;
+            while (!done && ls_iter < max_ls) {
+                if (tensor::math::abs(bracket[1] - bracket[0]) * d_norm < tolerance_change) break;
+
+                t = cubic_interpolate(bracket[0], bracket_f[0], bracket_gtd[0],
+                                      bracket[1], bracket_f[1], bracket_gtd[1]);
+
+                // Keeps the trial step away from the ends of the interval
+                const T b_max = std::max(bracket[0], bracket[1]), b_min = std::min(bracket[0], bracket[1]);
+                const T eps = T(0.1) * (b_max - b_min);
+                if (std::min(b_max - t, t - b_min) < eps) {
+                    if (insufficient_progress || t >= b_max || t <= b_min) {
+                        t = tensor::math::abs(t - b_max) < tensor::math::abs(t - b_min) ? b_max - eps : b_min + eps;
+                        insufficient_progress = false;
+                    } else {
+                        insufficient_progress = true;
+                    }
+                } else {
+                    insufficient_progress = false;
+                }
+
+                gtd_new = evaluate_at(t, f_new, g_new);
+                ++ls_iter;
+
+                if (f_new > loss + c1 * t * gtd || f_new >= bracket_f[low]) {
+                    bracket[high] = t;
+                    bracket_f[high] = f_new;
+                    bracket_g[high] = g_new;
+                    bracket_gtd[high] = gtd_new;
+                    low = bracket_f[0] <= bracket_f[1] ? 0 : 1;
+                    high = 1 - low;
+                } else {
+                    if (tensor::math::abs(gtd_new) <= -c2 * gtd) {
+                        done = true;
+                    } else if (gtd_new * (bracket[high] - bracket[low]) >= T(0)) {
+                        bracket[high] = bracket[low];
+                        bracket_f[high] = bracket_f[low];
+                        bracket_g[high] = bracket_g[low];
+                        bracket_gtd[high] = bracket_gtd[low];
+                    }
+                    bracket[low] = t;
+                    bracket_f[low] = f_new;
+                    bracket_g[low] = g_new;
+                    bracket_gtd[low] = gtd_new;
+                }
+            }
+
+            t = bracket[low];
+            loss = bracket_f[low];
+            g = bracket_g[low];
+        }
+
+        /// Parameters being optimized
+        std::vector<TensorS<T>> params;
+
+        /// Initial or fixed step
+        T lr;
+
+        /// Number of stored correction pairs
+        size_t history_size;
+
+        /// Maximum number of iterations per step
+        size_t max_iter;
+
+        /// Whether to use the strong Wolfe line search
+        bool line_search;
+
+        /// Tolerance on the gradient
+        T tolerance_grad;
+
+        /// Tolerance on the change of the loss and of the parameters
+        T tolerance_change;
+
+        /// Correction pairs s_k = x_{k+1} - x_k, y_k = g_{k+1} - g_k and rho_k = 1 / (y_k^T s_k)
+        std::deque<std::vector<T>> s_hist, y_hist;
+        std::deque<T> rho;
+
+        /// Last direction, last step and gradient before it
+        std::vector<T> d, g_prev;
+        T t = 0;
+
+        /// Scaling of the initial inverse Hessian approximation
+        T h_diag = 1;
+
+        /// Total number of iterations
+        size_t n_iter = 0;
+    };
+
+}
+
+#endif
@@ -0,0 +1,174 @@
+#ifndef DATA_PARALLEL_HPP
+#define DATA_PARALLEL_HPP
+
+#include <functional>
+#include <memory>
+#include <stdexcept>
+#include <utility>
+#include <vector>
+
+#include "core/tensor_core.hpp"
+#include "nn/model.hpp"
+#include "parallel/thread_pool.hpp"
+
+namespace tensor::parallel {
+
+    /**
+     * @brief Returns the range [lo, hi) of shard `shard` when n items are split into num_shards contiguous shards.
+     *
+     * Shard sizes differ by at most one.
+     */
+    inline std::pair<size_t, size_t> shard_range(size_t n, size_t shard, size_t num_shards) {
+        const size_t base = n / num_shards, extra = n % num_shards;
+        const size_t lo = shard * base + std::min(shard, extra);
+        return {lo, lo + base + (shard < extra ? 1 : 0)};
+    }
+
+    /**
+     * @brief Synchronous data-parallel gradient computation.
+     *
+     * The training data is split into a fixed number of shards. Every shard is
+     * processed by its own replica of the model, so every shard builds an
+     * independent graph and shards run concurrently on the thread pool without
+     * sharing any gradient buffer. Replicas receive the master parameters
+     * before each step; their gradients are then merged with a tree all-reduce
+     * and accumulated into the master parameters, where the existing optimizers
+     * (Adam, SGD) read them.
+     *
+     * Each shard is evaluated serially on one thread and the reduction tree only
+     * depends on the number of shards, so the gradients are bit-identical for
+     * any number of threads. Use at least as many shards as threads.
+     *
+     * Usage:
+     * @code
+     * DataParallel<T> dp(model, [&]() { return std::make_unique<Net>(hidden); }, 8);
+     * optim.zero_grad();
+     * T loss = dp.compute_gradients([&](const Model<T> &net, size_t shard, size_t num_shards) {
+     *     auto [lo, hi] = shard_range(N, shard, num_shards);
+     *     ...
+     *     return shard_loss;
+     * });
+     * optim.step();
+     * @endcode
+     *
+     * @tparam T Numeric type
+     */
+    template<Numeric T>
+    class DataParallel {
+    public:
+
+        /// Creates a model with the architecture of the master model
+        using ModelFactory = std::function<std::unique_ptr<nn::Model<T>>()>;
+
+        /**
+         * @brief Computes the loss of one shard on the given replica.
+         *
+         * The total loss is the sum of the shard losses, so a mean over the data
+         * must be scaled by the fraction of the data in the shard. The closure may
+         * run concurrently for different shards and must only write to per-shard state.
+         */
+        using ShardLoss = std::function<TensorS<T>(const nn::Model<T> &, size_t, size_t)>;
+
+        /**
+         * @param model Master model, whose parameters are updated by the optimizer
+         * @param factory Creates the replicas; their parameters are overwritten at every step
+         * @param num_shards Number of shards (and replicas)
+         * @throws std::runtime_error if the replicas do not match the master model
+         */
+        DataParallel(const nn::Model<T> &model, ModelFactory factory, size_t num_shards)
+                : params(model.getParams())
+        {
+            if (num_shards == 0) throw std::runtime_error("DataParallel requires at least one shard");
+            replicas.reserve(num_shards);
+            replica_params.reserve(num_shards);
+            for (size_t s = 0; s < num_shards; ++s) {
+                replicas.push_back(factory());
+                replica_params.push_back(replicas.back()->getParams());
+                const auto &rp = replica_params.back();
+                if (rp.size() != params.size())
+                    throw std::runtime_error("DataParallel replica does not match the model");
+                for (size_t i = 0; i < rp.size(); ++i) {
+                    if (rp[i]->shape != params[i]->shape || !rp[i]->requires_grad)
+                        throw std::runtime_error("DataParallel replica does not match the model");
+                }
+            }
+        }
+
+        /**
+         * @return the number of shards
+         */
+        size_t num_shards() const {
+            return replicas.size();
+        }
+
+        /**
+         * @brief Computes the gradients of the sum of the shard losses.
+         *
+         * Gradients and Hessian diagonals are accumulated into the master parameters.
+         *
+         * @param loss_fn Loss of a shard
+         * @return the total loss
+         */
+        T compute_gradients(const ShardLoss &loss_fn)
+        {
+            const size_t n = replicas.size();
+            std::vector<T> losses(n);
+
+            pool().run_tasks(n, [&](size_t s) {
+                // Shards run serially so that the result does not depend on the thread count
+                ThreadPool::SerialScope serial;
+                for (size_t i = 0; i < params.size(); ++i) {
+                    replica_params[s][i]->data = params[i]->data;
+                    replica_params[s][i]->zero_grad();
+                }
+                auto loss = loss_fn(*replicas[s], s, n);
+                loss->backward();
+                losses[s] = loss->data[0];
+            });
+
+            // Tree all-reduce: at level k replica s accumulates replica s + k
+            for (size_t k = 1; k < n; k *= 2) {
+                const size_t pairs = (n + 2 * k - 1) / (2 * k);
+                pool().run_tasks(pairs, [&](size_t j) {
+                    const size_t dst = 2 * k * j, src = dst + k;
+                    if (src >= n) return;
+                    accumulate(replica_params[dst], replica_params[src]);
+                });
+            }
+            accumulate(params, replica_params[0]);
+
+            T total = 0;
+            for (auto l: losses) total += l;
+            return total;
+        }
+
+    private:
+
+        /// Adds the gradients and Hessians of src into dst
+        static void accumulate(const std::vector<TensorS<T>> &dst, const std::vector<TensorS<T>> &src)
+        {
+            for (size_t i = 0; i < dst.size(); ++i) {
+                auto &d = *dst[i];
+                const auto &s = *src[i];
+                parallel_for(0, d.grad.size(), [&](size_t lo, size_t hi) {
+                    for (size_t j = lo; j < hi; ++j) {
+                        d.grad[j] += s.grad[j];
+                        d.hess[j] += s.hess[j];
+                    }
+                });
+            }
+        }
+
+        /// Parameters of the master model
+        std::vector<TensorS<T>> params;
+
+        /// Model replicas, one per shard
+        std::vector<std::unique_ptr<nn::Model<T>>> replicas;
+
+        /// Parameters of every replica, in the order of params
+        std::vector<std::vector<TensorS<T>>> replica_params;
+    };
+
+}
+
+#endif
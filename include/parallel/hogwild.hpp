@@ -0,0 +1,277 @@
+#ifndef HOGWILD_HPP
+#define HOGWILD_HPP
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cmath>
+#include <exception>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <stdexcept>
+#include <thread>
+#include <vector>
+
+#include "core/tensor_core.hpp"
+#include "nn/model.hpp"
+#include "parallel/thread_pool.hpp"
+#include "utils/random.hpp"
+
+namespace tensor::parallel {
+
+    /**
+     * @brief Update rule applied by the Hogwild workers.
+     */
+    enum class HogwildRule { SGD, Adam };
+
+    /**
+     * @brief Settings of asynchronous Hogwild training.
+     */
+    template<Numeric T>
+    struct HogwildOptions {
+        /// Number of worker threads, started by every run independently of the thread pool
+        size_t num_workers = 1;
+
+        /// Number of updates applied by every worker
+        size_t steps_per_worker = 100;
+
+        /// Update rule
+        HogwildRule rule = HogwildRule::SGD;
+
+        /// Learning rate
+        T lr = T(1e-3);
+
+        /// Adam moment decays and epsilon
+        T beta1 = T(0.9), beta2 = T(0.999), eps = T(1e-8);
+
+        /// Weight decay, added to the gradient as in optim::Adam (Adam only)
+        T weight_decay = T(0);
+
+        /// Seed of the worker generators: worker w draws from its own stream of this seed
+        uint64_t seed = 0;
+    };
+
+    /**
+     * @brief Statistics of a Hogwild run.
+     *
+     * The staleness of an update is the number of updates applied by other
+     * workers between the moment the worker read the parameters and the
+     * moment it wrote its own update.
+     */
+    struct HogwildStats {
+        size_t updates = 0;
+        double mean_staleness = 0;
+        size_t max_staleness = 0;
+        double seconds = 0;
+
+        double updates_per_second() const {
+            return seconds > 0 ? updates / seconds : 0;
+        }
+    };
+
+    /**
+     * @brief Asynchronous lock-free training (Hogwild).
+     *
+     * Every worker owns a replica of the model. It repeatedly copies the shared
+     * parameters into its replica, computes the loss of a mini-batch it samples
+     * itself, runs backward and applies an SGD or Adam update directly to the
+     * shared parameter buffers, without locks or barriers. Concurrent updates
+     * may interleave or overwrite each other: for sparse, small updates this
+     * noise does not prevent convergence, while removing every synchronization
+     * point (Recht et al., Hogwild!, 2011).
+     *
+     * The shared buffers are accessed element-wise with relaxed atomic loads and
+     * stores, so there is no data race in the C++ sense, but a read-modify-write
+     * is not atomic as a whole. With Adam the moment buffers are shared too and
+     * the bias correction uses the global update count.
+     *
+     * Every worker is a dedicated std::thread, not a task of the thread pool,
+     * so num_workers updates are always in flight concurrently, whatever the
+     * size of the pool, and the staleness and throughput describe that number
+     * of workers. Inside a worker the operations run serially.
+     *
+     * The shared parameters are those of the master model, so training can move
+     * between Hogwild and the synchronous optimizers at any time.
+     *
+     * @tparam T Numeric type
+     */
+    template<Numeric T>
+    class Hogwild {
+    public:
+
+        /// Creates a model with the architecture of the master model
+        using ModelFactory = std::function<std::unique_ptr<nn::Model<T>>()>;
+
+        /**
+         * @brief Computes the loss of a mini-batch on the worker replica.
+         *
+         * Called with the replica, the worker index and the worker generator,
+         * which must be used to sample the batch. Runs concurrently on several workers.
+         */
+        using BatchLoss = std::function<TensorS<T>(const nn::Model<T> &, size_t, Philox &)>;
+
+        /**
+         * @param model Master model holding the shared parameters
+         * @param factory Creates the worker replicas
+         * @param options Training settings
+         * @throws std::runtime_error if the replicas do not match the master model
+         */
+        Hogwild(const nn::Model<T> &model, ModelFactory factory, HogwildOptions<T> options)
+                : params(model.getParams()), options(options)
+        {
+            if (options.num_workers == 0) throw std::runtime_error("Hogwild requires at least one worker");
+            for (size_t w = 0; w < options.num_workers; ++w) {
+                replicas.push_back(factory());
+                replica_params.push_back(replicas.back()->getParams());
+                const auto &rp = replica_params.back();
+                if (rp.size() != params.size())
+                    throw std::runtime_error("Hogwild replica does not match the model");
+                for (size_t i = 0; i < rp.size(); ++i) {
+                    if (rp[i]->shape != params[i]->shape || !rp[i]->requires_grad)
+                        throw std::runtime_error("Hogwild replica does not match the model");
+                }
+            }
+            if (options.rule == HogwildRule::Adam) {
+                for (auto &p: params) {
+                    m.emplace_back(p->data.size(), T(0));
+                    v.emplace_back(p->data.size(), T(0));
+                }
+            }
+        }
+
+        /**
+         * @brief Runs steps_per_worker updates on every worker.
+         *
+         * Starts num_workers threads and joins them before returning. May be
+         * called repeatedly; the Adam state and the update count carry over.
+         *
+         * @param loss_fn Mini-batch loss
+         * @return statistics of the run
+         * @throws the first exception thrown by a worker, once all workers have stopped
+         */
+        HogwildStats run(const BatchLoss &loss_fn)
+        {
+            const size_t n = replicas.size();
+            std::vector<size_t> staleness_sum(n, 0), staleness_max(n, 0);
+            const size_t updates_before = version.load();
+
+            std::mutex error_mutex;
+            std::exception_ptr error;
+
+            auto worker = [&](size_t w) {
+                ThreadPool::SerialScope serial;
+                Philox rng(options.seed, w + n * runs);
+                auto &local = replica_params[w];
+                for (size_t step = 0; step < options.steps_per_worker; ++step) {
+                    const size_t read_version = version.load(std::memory_order_acquire);
+                    for (size_t i = 0; i < params.size(); ++i) {
+                        read_shared(params[i]->data, local[i]->data);
+                        local[i]->zero_grad();
+                    }
+
+                    loss_fn(*replicas[w], w, rng)->backward();
+
+                    const size_t t = version.fetch_add(1, std::memory_order_acq_rel) + 1;
+                    const size_t stale = t - 1 - read_version;
+                    staleness_sum[w] += stale;
+                    staleness_max[w] = std::max(staleness_max[w], stale);
+                    apply(local, t);
+                }
+            };
+
+            auto start = std::chrono::steady_clock::now();
+            std::vector<std::thread> threads;
+            threads.reserve(n);
+            for (size_t w = 0; w < n; ++w) {
+                threads.emplace_back([&, w]() {
+                    try {
+                        worker(w);
+                    } catch (...) {
+                        std::lock_guard<std::mutex> lock(error_mutex);
+                        if (!error) error = std::current_exception();
+                    }
+                });
+            }
+            for (auto &t: threads) t.join();
+            ++runs;
+            if (error) std::rethrow_exception(error);
+
+            HogwildStats stats;
+            stats.seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+            stats.updates = version.load() - updates_before;
+            size_t total = 0;
+            for (size_t w = 0; w < n; ++w) {
+                total += staleness_sum[w];
+                stats.max_staleness = std::max(stats.max_staleness, staleness_max[w]);
+            }
+            stats.mean_staleness = stats.updates ? double(total) / stats.updates : 0;
+            return stats;
+        }
+
+    private:
+
+        static void read_shared(std::vector<T> &shared, std::vector<T> &local)
+        {
+            for (size_t j = 0; j < shared.size(); ++j)
+                local[j] = std::atomic_ref<T>(shared[j]).load(std::memory_order_relaxed);
+        }
+
+        /// Applies the update computed from the gradients of a replica to the shared parameters
+        void apply(const std::vector<TensorS<T>> &local, size_t t)
+        {
+            const T lr = options.lr;
+            if (options.rule == HogwildRule::SGD) {
+                for (size_t i = 0; i < params.size(); ++i) {
+                    auto &data = params[i]->data;
+                    const auto &grad = local[i]->grad;
+                    for (size_t j = 0; j < data.size(); ++j) {
+                        std::atomic_ref<T> x(data[j]);
+                        x.store(x.load(std::memory_order_relaxed) - lr * grad[j], std::memory_order_relaxed);
+                    }
+                }
+                return;
+            }
+
+            const T b1 = options.beta1, b2 = options.beta2;
+            const T step_size = lr * std::sqrt(1 - std::pow(b2, T(t))) / (1 - std::pow(b1, T(t)));
+            for (size_t i = 0; i < params.size(); ++i) {
+                auto &data = params[i]->data;
+                const auto &grad = local[i]->grad;
+                for (size_t j = 0; j < data.size(); ++j) {
+                    std::atomic_ref<T> mj(m[i][j]), vj(v[i][j]), x(data[j]);
+                    const T g = grad[j] + options.weight_decay * x.load(std::memory_order_relaxed);
+                    const T mt = b1 * mj.load(std::memory_order_relaxed) + (1 - b1) * g;
+                    const T vt = b2 * vj.load(std::memory_order_relaxed) + (1 - b2) * g * g;
+                    mj.store(mt, std::memory_order_relaxed);
+                    vj.store(vt, std::memory_order_relaxed);
+                    x.store(x.load(std::memory_order_relaxed) - step_size * mt / (std::sqrt(vt) + options.eps),
+                            std::memory_order_relaxed);
+                }
+            }
+        }
+
+        /// Shared parameters (those of the master model)
+        std::vector<TensorS<T>> params;
+
+        HogwildOptions<T> options;
+
+        /// Worker replicas
+        std::vector<std::unique_ptr<nn::Model<T>>> replicas;
+
+        /// Parameters of every replica, in the order of params
+        std::vector<std::vector<TensorS<T>>> replica_params;
+
+        /// Shared Adam moments
+        std::vector<std::vector<T>> m, v;
+
+        /// Number of updates applied to the shared parameters
+        std::atomic<size_t> version{0};
+
+        /// Number of calls to run, used to give every run new worker streams
+        size_t runs = 0;
+    };
+
+}
+
+#endif
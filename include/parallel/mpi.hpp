@@ -0,0 +1,223 @@
+#ifndef MPI_HPP
+#define MPI_HPP
+
+#ifdef USE_MPI
+
+#include <algorithm>
+#include <functional>
+#include <memory>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#include <mpi.h>
+
+#include "core/tensor_core.hpp"
+#include "optim/optim.hpp"
+#include "parallel/data_parallel.hpp"
+
+/**
+ * Optional multi-process backend, enabled with -DUSE_MPI.
+ *
+ * Every rank holds a full copy of the model and processes its own partition
+ * of the training data; the parameter gradients are summed across ranks after
+ * each backward, so every rank sees the gradient of the global loss.
+ */
+namespace tensor::parallel::mpi {
+
+    /**
+     * @brief RAII initialization of MPI.
+     *
+     * Only the thread that created the environment issues MPI calls, while the
+     * thread pool keeps running the tensor ops of each rank.
+     */
+    class Environment {
+    public:
+        Environment(int &argc, char **&argv) {
+            int provided;
+            MPI_Init_thread(&argc, &argv, MPI_THREAD_FUNNELED, &provided);
+        }
+
+        ~Environment() {
+            MPI_Finalize();
+        }
+
+        Environment(const Environment &) = delete;
+        Environment &operator=(const Environment &) = delete;
+    };
+
+    template<Numeric T>
+    MPI_Datatype datatype() {
+        if constexpr (std::is_same_v<T, float>) return MPI_FLOAT;
+        else if constexpr (std::is_same_v<T, double>) return MPI_DOUBLE;
+        else return MPI_LONG_DOUBLE;
+    }
+
+    inline int rank(MPI_Comm comm = MPI_COMM_WORLD) {
+        int r;
+        MPI_Comm_rank(comm, &r);
+        return r;
+    }
+
+    inline int size(MPI_Comm comm = MPI_COMM_WORLD) {
+        int s;
+        MPI_Comm_size(comm, &s);
+        return s;
+    }
+
+    /**
+     * @brief Returns the number of ranks of comm running on the node of the calling rank.
+     *
+     * Ranks sharing a node share its cores, so each should use about
+     * hardware_concurrency / local_size threads.
+     */
+    inline int local_size(MPI_Comm comm = MPI_COMM_WORLD) {
+        MPI_Comm node;
+        MPI_Comm_split_type(comm, MPI_COMM_TYPE_SHARED, rank(comm), MPI_INFO_NULL, &node);
+        const int s = size(node);
+        MPI_Comm_free(&node);
+        return s;
+    }
+
+    /**
+     * @brief Returns the range [lo, hi) of the n data points assigned to the calling rank.
+     */
+    inline std::pair<size_t, size_t> partition(size_t n, MPI_Comm comm = MPI_COMM_WORLD) {
+        return shard_range(n, rank(comm), size(comm));
+    }
+
+    /**
+     * @brief Copies the parameters of rank root to every rank.
+     *
+     * Called once after the model is created, so that all ranks start from the same weights.
+     */
+    template<Numeric T>
+    void broadcast_params(const std::vector<TensorS<T>> &params, int root = 0, MPI_Comm comm = MPI_COMM_WORLD)
+    {
+        for (auto &p: params) {
+            MPI_Bcast(p->data.data(), static_cast<int>(p->data.size()), datatype<T>(), root, comm);
+        }
+    }
+
+    /**
+     * @brief Sums the gradients of the parameters across ranks.
+     *
+     * All gradients are packed in a single buffer, so the reduction is a single
+     * collective call. The result is the gradient of the sum of the rank losses:
+     * a mean over the data must be scaled by the fraction of the data on the rank.
+     *
+     * @param params Parameters, in the same order on every rank
+     * @param include_hess If true the Hessian diagonals are summed as well
+     * @param comm Communicator
+     */
+    template<Numeric T>
+    void allreduce_gradients(const std::vector<TensorS<T>> &params, bool include_hess = false,
+                             MPI_Comm comm = MPI_COMM_WORLD)
+    {
+        size_t total = 0;
+        for (auto &p: params) total += p->grad.size();
+        std::vector<T> buffer(include_hess ? 2 * total : total);
+
+        size_t offset = 0;
+        for (auto &p: params) {
+            std::copy(p->grad.begin(), p->grad.end(), buffer.begin() + offset);
+            if (include_hess) std::copy(p->hess.begin(), p->hess.end(), buffer.begin() + total + offset);
+            offset += p->grad.size();
+        }
+
+        MPI_Allreduce(MPI_IN_PLACE, buffer.data(), static_cast<int>(buffer.size()), datatype<T>(), MPI_SUM, comm);
+
+        offset = 0;
+        for (auto &p: params) {
+            std::copy(buffer.begin() + offset, buffer.begin() + offset + p->grad.size(), p->grad.begin());
+            if (include_hess) {
+                std::copy(buffer.begin() + total + offset, buffer.begin() + total + offset + p->hess.size(),
+                          p->hess.begin());
+            }
+            offset += p->grad.size();
+        }
+    }
+
+    /**
+     * @brief Optimizer for multi-process training.
+     *
+     * step() sums the gradients across ranks and then updates the parameters
+     * with an inner optimizer (e.g. Adam or SGD).
+     *
+     * With replicated state every rank updates all the parameters and keeps a
+     * full copy of the optimizer state. With sharded state every parameter is
+     * owned by one rank, which alone stores its optimizer state and updates it;
+     * the updated values are then broadcast from the owners. Parameters are
+     * assigned to the ranks greedily by size.
+     *
+     * @tparam T Numeric type
+     */
+    template<Numeric T>
+    class DistributedOptimizer : public optim::Optimizer<T> {
+    public:
+
+        /// Creates the inner optimizer over the given parameters
+        using OptimizerFactory = std::function<std::unique_ptr<optim::Optimizer<T>>(const std::vector<TensorS<T>> &)>;
+
+        /**
+         * @param params Parameters, in the same order on every rank
+         * @param factory Creates the inner optimizer
+         * @param shard_state If true the optimizer state is sharded across ranks
+         * @param include_hess If true the Hessian diagonals are summed across ranks as well
+         * @param comm Communicator
+         */
+        DistributedOptimizer(const std::vector<TensorS<T>> &params, const OptimizerFactory &factory,
+                             bool shard_state = false, bool include_hess = false, MPI_Comm comm = MPI_COMM_WORLD)
+                : params(params), owner(params.size(), 0), shard_state(shard_state),
+                  include_hess(include_hess), comm(comm)
+        {
+            std::vector<TensorS<T>> owned = params;
+            if (shard_state) {
+                std::vector<size_t> load(size(comm), 0);
+                owned.clear();
+                for (size_t i = 0; i < params.size(); ++i) {
+                    owner[i] = static_cast<int>(std::min_element(load.begin(), load.end()) - load.begin());
+                    load[owner[i]] += params[i]->data.size();
+                    if (owner[i] == rank(comm)) owned.push_back(params[i]);
+                }
+            }
+            inner = factory(owned);
+        }
+
+        void step() override {
+            allreduce_gradients(params, include_hess, comm);
+            inner->step();
+            if (shard_state) {
+                for (size_t i = 0; i < params.size(); ++i) {
+                    auto &p = params[i];
+                    MPI_Bcast(p->data.data(), static_cast<int>(p->data.size()), datatype<T>(), owner[i], comm);
+                }
+            }
+        }
+
+        void zero_grad() override {
+            for (auto &p: params) {
+                p->zero_grad();
+            }
+        }
+
+    private:
+        /// All the parameters of the model
+        std::vector<TensorS<T>> params;
+
+        /// Rank owning the optimizer state of each parameter
+        std::vector<int> owner;
+
+        /// Optimizer of the parameters updated by this rank
+        std::unique_ptr<optim::Optimizer<T>> inner;
+
+        bool shard_state;
+        bool include_hess;
+        MPI_Comm comm;
+    };
+
+}
+
+#endif
+
+#endif
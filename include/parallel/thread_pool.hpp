@@ -0,0 +1,509 @@
+#ifndef THREAD_POOL_HPP
+#define THREAD_POOL_HPP
+
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <cstdlib>
+#include <deque>
+#include <exception>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+#ifdef __linux__
+    #include <pthread.h>
+    #include <sched.h>
+#endif
+
+#ifdef USE_BLAS
+    #include <cblas.h>
+#endif
+
+namespace tensor::parallel {
+
+    /**
+     * @brief Work-stealing thread pool.
+     *
+     * Every worker owns a task deque: it pops tasks from the back of its own
+     * deque and, when that is empty, steals from the front of the others.
+     * Threads waiting for a batch of tasks help executing queued tasks instead
+     * of blocking, so the calling thread counts as one of the pool threads.
+     *
+     * Tasks that start a nested parallel region run it serially on the current
+     * thread, which prevents deadlocks and oversubscription.
+     */
+    class ThreadPool {
+    public:
+
+        /**
+         * @brief Creates a pool.
+         *
+         * @param num_threads Total number of threads, including the calling thread
+         * @param pin If true, worker i is pinned to CPU (i + 1) modulo the number of CPUs
+         */
+        explicit ThreadPool(size_t num_threads, bool pin = false)
+        {
+            const size_t n_workers = num_threads > 1 ? num_threads - 1 : 0;
+            queues.reserve(n_workers);
+            for (size_t i = 0; i < n_workers; ++i) queues.push_back(std::make_unique<Queue>());
+            workers.reserve(n_workers);
+            for (size_t i = 0; i < n_workers; ++i) {
+                workers.emplace_back([this, i]() { worker_loop(i); });
+                if (pin) pin_thread(workers.back(), i + 1);
+            }
+        }
+
+        ~ThreadPool()
+        {
+            {
+                std::lock_guard<std::mutex> lock(sleep_mutex);
+                stop = true;
+            }
+            sleep_cv.notify_all();
+            for (auto &w: workers) w.join();
+        }
+
+        ThreadPool(const ThreadPool &) = delete;
+        ThreadPool &operator=(const ThreadPool &) = delete;
+
+        /**
+         * @return the number of threads of the pool, including the calling thread
+         */
+        size_t num_threads() const {
+            return workers.size() + 1;
+        }
+
+        /**
+         * @brief Queues a task.
+         *
+         * A task submitted from a worker goes to the back of its own deque,
+         * otherwise tasks are distributed round-robin across the workers.
+         * Without workers the task runs immediately on the calling thread.
+         */
+        void submit(std::function<void()> task)
+        {
+            if (workers.empty()) {
+                task();
+                return;
+            }
+            const size_t q = (current_pool() == this && worker_index() >= 0)
+                             ? static_cast<size_t>(worker_index())
+                             : next_queue.fetch_add(1, std::memory_order_relaxed) % queues.size();
+            // Counted before it is published, so that a thief popping it
+            // right away never decrements pending below zero
+            {
+                std::lock_guard<std::mutex> lock(sleep_mutex);
+                ++pending;
+            }
+            {
+                std::lock_guard<std::mutex> lock(queues[q]->mutex);
+                queues[q]->tasks.push_back(std::move(task));
+            }
+            sleep_cv.notify_one();
+        }
+
+        /**
+         * @brief Runs one queued task on the calling thread, if any.
+         *
+         * @return true if a task was executed
+         */
+        bool run_one()
+        {
+            const int self = current_pool() == this ? worker_index() : -1;
+            std::function<void()> task;
+            if (!pop(self, task)) return false;
+            execute(task);
+            return true;
+        }
+
+        /**
+         * @brief Runs f(i) for every i in [0, n) and waits for completion.
+         *
+         * The calling thread takes part in the execution. Inside a parallel
+         * region, or without workers, the loop runs serially. The first
+         * exception thrown by a task is rethrown on the calling thread.
+         */
+        template<typename F>
+        void run_tasks(size_t n, F &&f)
+        {
+            if (n == 0) return;
+            if (n == 1 || workers.empty() || in_parallel_region()) {
+                for (size_t i = 0; i < n; ++i) f(i);
+                return;
+            }
+
+            struct State {
+                std::atomic<size_t> remaining;
+                std::mutex error_mutex;
+                std::exception_ptr error;
+            };
+            auto state = std::make_shared<State>();
+            state->remaining = n;
+
+            for (size_t i = 0; i < n; ++i) {
+                submit([state, &f, i]() {
+                    try {
+                        f(i);
+                    } catch (...) {
+                        std::lock_guard<std::mutex> lock(state->error_mutex);
+                        if (!state->error) state->error = std::current_exception();
+                    }
+                    state->remaining.fetch_sub(1, std::memory_order_acq_rel);
+                });
+            }
+
+            wait_until([&]() { return state->remaining.load(std::memory_order_acquire) == 0; });
+            if (state->error) std::rethrow_exception(state->error);
+        }
+
+        /**
+         * @brief Helps executing queued tasks until done() returns true.
+         */
+        template<typename Pred>
+        void wait_until(Pred &&done)
+        {
+            while (!done()) {
+                if (!run_one()) std::this_thread::yield();
+            }
+        }
+
+        /**
+         * @return true if the calling thread is executing a pool task
+         */
+        static bool in_parallel_region() {
+            return region_depth() > 0;
+        }
+
+        /**
+         * @brief Scope in which the calling thread behaves as inside a parallel region.
+         *
+         * Parallel loops started within the scope run serially on the calling thread.
+         */
+        class SerialScope {
+        public:
+            SerialScope() { ++region_depth(); }
+            ~SerialScope() { --region_depth(); }
+
+            SerialScope(const SerialScope &) = delete;
+            SerialScope &operator=(const SerialScope &) = delete;
+        };
+
+    private:
+
+        struct Queue {
+            std::mutex mutex;
+            std::deque<std::function<void()>> tasks;
+        };
+
+        static int &worker_index() {
+            static thread_local int index = -1;
+            return index;
+        }
+
+        static ThreadPool *&current_pool() {
+            static thread_local ThreadPool *pool = nullptr;
+            return pool;
+        }
+
+        static int &region_depth() {
+            static thread_local int depth = 0;
+            return depth;
+        }
+
+        /// Pops from the back of the own deque, then steals from the front of the others
+        bool pop(int self, std::function<void()> &task)
+        {
+            const size_t n = queues.size();
+            if (self >= 0) {
+                auto &q = *queues[self];
+                std::lock_guard<std::mutex> lock(q.mutex);
+                if (!q.tasks.empty()) {
+                    task = std::move(q.tasks.back());
+                    q.tasks.pop_back();
+                    --pending;
+                    return true;
+                }
+            }
+            const size_t start = self >= 0 ? static_cast<size_t>(self) + 1 : 0;
+            for (size_t k = 0; k < n; ++k) {
+                auto &q = *queues[(start + k) % n];
+                std::lock_guard<std::mutex> lock(q.mutex);
+                if (!q.tasks.empty()) {
+                    task = std::move(q.tasks.front());
+                    q.tasks.pop_front();
+                    --pending;
+                    return true;
+                }
+            }
+            return false;
+        }
+
+        void execute(std::function<void()> &task)
+        {
+            ++region_depth();
+            task();
+            --region_depth();
+        }
+
+        void worker_loop(size_t index)
+        {
+            worker_index() = static_cast<int>(index);
+            current_pool() = this;
+            while (true) {
+                std::function<void()> task;
+                if (pop(static_cast<int>(index), task)) {
+                    execute(task);
+                    continue;
+                }
+                std::unique_lock<std::mutex> lock(sleep_mutex);
+                sleep_cv.wait(lock, [this]() { return stop || pending > 0; });
+                if (stop && pending == 0) return;
+            }
+        }
+
+        static void pin_thread([[maybe_unused]] std::thread &t, [[maybe_unused]] size_t cpu)
+        {
+#ifdef __linux__
+            const size_t n_cpus = std::max(1u, std::thread::hardware_concurrency());
+            cpu_set_t set;
+            CPU_ZERO(&set);
+            CPU_SET(cpu % n_cpus, &set);
+            pthread_setaffinity_np(t.native_handle(), sizeof(cpu_set_t), &set);
+#endif
+        }
+
+        std::vector<std::unique_ptr<Queue>> queues;
+        std::vector<std::thread> workers;
+
+        std::mutex sleep_mutex;
+        std::condition_variable sleep_cv;
+
+        /// Number of queued tasks not yet taken by a thread, incremented before the push
+        std::atomic<size_t> pending{0};
+
+        std::atomic<size_t> next_queue{0};
+        bool stop = false;
+    };
+
+    /**
+     * @brief Global threading configuration.
+     */
+    struct Config {
+        /// Number of threads of the global pool (including the calling thread)
+        size_t num_threads;
+
+        /// Whether pool workers are pinned to CPUs
+        bool pin = false;
+
+        /// Minimum number of elements per task of an element-wise kernel
+        size_t grain_size = 1 << 15;
+
+        /// Whether reductions must be reproducible bit-wise (see set_deterministic)
+        bool deterministic = false;
+    };
+
+    /**
+     * @brief Returns the default number of threads.
+     *
+     * Read from the TENSOR_NUM_THREADS environment variable if set,
+     * otherwise the number of hardware threads.
+     */
+    inline size_t default_num_threads() {
+        if (const char *env = std::getenv("TENSOR_NUM_THREADS")) {
+            long n = std::strtol(env, nullptr, 10);
+            if (n > 0) return static_cast<size_t>(n);
+        }
+        return std::max(1u, std::thread::hardware_concurrency());
+    }
+
+    inline Config &config() {
+        static Config cfg{default_num_threads()};
+        return cfg;
+    }
+
+    /**
+     * @brief Sets the number of threads used by BLAS calls.
+     *
+     * No-op when the library is built without BLAS.
+     */
+    inline void set_blas_num_threads([[maybe_unused]] size_t n) {
+#ifdef USE_BLAS
+        openblas_set_num_threads(static_cast<int>(n));
+#endif
+    }
+
+    /**
+     * @return the number of threads BLAS calls should use: one in deterministic mode,
+     *         the number of threads of the pool otherwise
+     */
+    inline size_t blas_num_threads() {
+        return config().deterministic ? 1 : config().num_threads;
+    }
+
+    inline std::unique_ptr<ThreadPool> &pool_instance() {
+        static std::unique_ptr<ThreadPool> instance = [] {
+            set_blas_num_threads(blas_num_threads());
+            return std::make_unique<ThreadPool>(config().num_threads, config().pin);
+        }();
+        return instance;
+    }
+
+    /**
+     * @brief Returns the global thread pool used by the tensor ops.
+     */
+    inline ThreadPool &pool() {
+        return *pool_instance();
+    }
+
+    /**
+     * @brief Sets the number of threads of the global pool.
+     *
+     * BLAS is configured with the same number of threads: BLAS calls are issued
+     * outside parallel regions, while the pool workers are idle, so the two never
+     * compete for cores. Must not be called while ops are running.
+     *
+     * @param n Number of threads, including the calling thread
+     */
+    inline void set_num_threads(size_t n) {
+        config().num_threads = std::max<size_t>(n, 1);
+        pool_instance().reset();
+        pool_instance() = std::make_unique<ThreadPool>(config().num_threads, config().pin);
+        set_blas_num_threads(blas_num_threads());
+    }
+
+    /**
+     * @return the number of threads of the global pool
+     */
+    inline size_t get_num_threads() {
+        return pool().num_threads();
+    }
+
+    /**
+     * @brief Enables or disables pinning of the pool workers to CPUs.
+     *
+     * Recreates the global pool; must not be called while ops are running.
+     */
+    inline void set_pinning(bool pin) {
+        config().pin = pin;
+        set_num_threads(config().num_threads);
+    }
+
+    /**
+     * @brief Sets the minimum number of elements processed by a task.
+     *
+     * Loops shorter than the grain size run serially.
+     */
+    inline void set_grain_size(size_t grain) {
+        config().grain_size = std::max<size_t>(grain, 1);
+    }
+
+    inline size_t grain_size() {
+        return config().grain_size;
+    }
+
+    /**
+     * @brief Enables or disables the deterministic mode.
+     *
+     * In deterministic mode every parallel reduction has a fixed shape that only
+     * depends on the sizes of the operands, so results are bit-wise identical
+     * from run to run and for any number of threads:
+     * - the bias gradient of broadcast_add is reduced over fixed blocks of rows;
+     * - the concurrent backward (backward with parallel = true) accumulates a
+     *   parent shared by several nodes through per-consumer partials added in
+     *   a fixed order, also when it runs on a single thread. Its result may
+     *   differ in the last bits from the one of the serial backward, which is
+     *   reproducible as well;
+     * - BLAS runs single-threaded.
+     *
+     * sum and mean are reproducible in both modes.
+     */
+    inline void set_deterministic(bool deterministic) {
+        config().deterministic = deterministic;
+        set_blas_num_threads(blas_num_threads());
+    }
+
+    inline bool deterministic() {
+        return config().deterministic;
+    }
+
+    /**
+     * @brief Scoped override of the BLAS thread count.
+     *
+     * Used by code that issues BLAS calls from several pool threads at once.
+     */
+    class BlasThreadsGuard {
+    public:
+        explicit BlasThreadsGuard(size_t n) {
+            set_blas_num_threads(n);
+        }
+
+        ~BlasThreadsGuard() {
+            set_blas_num_threads(blas_num_threads());
+        }
+
+        BlasThreadsGuard(const BlasThreadsGuard &) = delete;
+        BlasThreadsGuard &operator=(const BlasThreadsGuard &) = delete;
+    };
+
+    /**
+     * @brief Splitting of a loop into tasks.
+     */
+    struct Partition {
+        /// Number of chunks
+        size_t chunks;
+
+        /// Number of iterations per chunk (the last one may be shorter)
+        size_t chunk_size;
+    };
+
+    /**
+     * @brief Splits n iterations into at most 4 chunks per thread of at least grain iterations.
+     */
+    inline Partition partition(size_t n, size_t grain) {
+        if (n == 0) return {0, 0};
+        const size_t threads = ThreadPool::in_parallel_region() ? 1 : pool().num_threads();
+        size_t chunks = std::min((n + grain - 1) / std::max<size_t>(grain, 1), 4 * threads);
+        chunks = std::max<size_t>(chunks, 1);
+        if (threads == 1) chunks = 1;
+        const size_t chunk_size = (n + chunks - 1) / chunks;
+        return {(n + chunk_size - 1) / chunk_size, chunk_size};
+    }
+
+    /**
+     * @brief Runs f(lo, hi) over disjoint sub-ranges covering [begin, end).
+     *
+     * @param begin First iteration
+     * @param end One past the last iteration
+     * @param f Loop body called on every chunk
+     * @param grain Minimum number of iterations per chunk
+     */
+    template<typename F>
+    void parallel_for(size_t begin, size_t end, F &&f, size_t grain = grain_size())
+    {
+        if (end <= begin) return;
+        auto part = partition(end - begin, grain);
+        if (part.chunks == 1) {
+            f(begin, end);
+            return;
+        }
+        pool().run_tasks(part.chunks, [&](size_t c) {
+            const size_t lo = begin + c * part.chunk_size;
+            const size_t hi = std::min(end, lo + part.chunk_size);
+            if (lo < hi) f(lo, hi);
+        });
+    }
+
+    /**
+     * @brief Returns the grain, in rows, of a loop over rows of row_size elements.
+     */
+    inline size_t row_grain(size_t row_size) {
+        return std::max<size_t>(1, grain_size() / std::max<size_t>(row_size, 1));
+    }
+
+}
+
+#endif
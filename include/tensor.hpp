@@ -3,13 +3,25 @@
 
 #include "core/tensor_core.hpp"
 #include "ops/arithmetic.hpp"
+#include "ops/reductions.hpp"
 #include "ops/activations.hpp"
 #include "ops/matmul.hpp"
+#include "ops/indexing.hpp"
+#include "ops/spmm.hpp"
 #include "utils/debug.hpp"
+#include "utils/random.hpp"
 #include "utils/tensor_utils.hpp"
 #include "optim/optim.hpp"
 #include "optim/adam.hpp"
+#include "optim/lbfgs.hpp"
+#include "optim/adahessian.hpp"
 #include "nn/layers.hpp"
 #include "nn/model.hpp"
+#include "nn/mlp.hpp"
+#include "nn/hessian.hpp"
+#include "nn/hutchinson.hpp"
+#include "parallel/data_parallel.hpp"
+#include "parallel/hogwild.hpp"
+#include "parallel/mpi.hpp"
 
 #endif
\ No newline at end of file
@@ -0,0 +1,188 @@
+#ifndef RANDOM_HPP
+#define RANDOM_HPP
+
+#include <array>
+#include <cmath>
+#include <cstdint>
+#include <limits>
+#include <numbers>
+
+namespace tensor {
+
+    /**
+     * @brief Counter-based random number generator (Philox4x32-10).
+     *
+     * Every 128-bit block of random bits is a pure function of a key (the seed)
+     * and a counter made of a stream id and a block index:
+     *
+     *     block(seed, stream, index) = Philox4x32-10(key = seed, counter = (index, stream))
+     *
+     * Different streams are independent sequences, and any position of a stream
+     * can be reached in O(1), so
+     * - large tensors are filled in parallel, each element reading the block at
+     *   its own index;
+     * - threads sample independently from their own stream of the same seed;
+     * - a run can be resumed by restoring the offset (skip-ahead).
+     *
+     * The generator also satisfies UniformRandomBitGenerator: operator() returns
+     * the 32-bit words of consecutive blocks, so it works with the standard
+     * distributions.
+     *
+     * Reference: J. K. Salmon et al., Parallel random numbers: as easy as 1, 2, 3, SC11.
+     */
+    class Philox {
+    public:
+        using result_type = uint32_t;
+
+        /// Random bits of one counter
+        using Block = std::array<uint32_t, 4>;
+
+        /**
+         * @param seed Key of the generator
+         * @param stream Stream id
+         * @param offset Position in the stream, in 32-bit words
+         */
+        explicit Philox(uint64_t seed = 0, uint64_t stream = 0, uint64_t offset = 0)
+                : key(seed), stream_id(stream), position(offset) {}
+
+        static constexpr result_type min() { return 0; }
+        static constexpr result_type max() { return std::numeric_limits<result_type>::max(); }
+
+        /**
+         * @brief Returns the next 32-bit word of the stream.
+         */
+        result_type operator()() {
+            const uint64_t index = position / 4;
+            if (index != cached_index) {
+                cache = block(index);
+                cached_index = index;
+            }
+            return cache[position++ % 4];
+        }
+
+        /**
+         * @brief Returns the 128 bits at a block index of the stream, without changing the state.
+         */
+        Block block(uint64_t index) const {
+            return philox(
+                    {static_cast<uint32_t>(index), static_cast<uint32_t>(index >> 32),
+                     static_cast<uint32_t>(stream_id), static_cast<uint32_t>(stream_id >> 32)},
+                    key
+            );
+        }
+
+        /**
+         * @brief Resets the key and moves to the beginning of stream 0.
+         */
+        void seed(uint64_t seed) {
+            key = seed;
+            stream_id = 0;
+            position = 0;
+            cached_index = NO_BLOCK;
+        }
+
+        uint64_t get_seed() const { return key; }
+
+        /**
+         * @brief Moves to the beginning of another stream.
+         */
+        void set_stream(uint64_t stream) {
+            stream_id = stream;
+            position = 0;
+            cached_index = NO_BLOCK;
+        }
+
+        uint64_t get_stream() const { return stream_id; }
+
+        /**
+         * @brief Moves to a position of the stream, in 32-bit words.
+         */
+        void set_offset(uint64_t offset) { position = offset; }
+
+        /**
+         * @return the position in the stream, in 32-bit words
+         */
+        uint64_t get_offset() const { return position; }
+
+        /**
+         * @brief Skips z words in O(1).
+         */
+        void discard(uint64_t z) { position += z; }
+
+        /**
+         * @brief Reserves n whole blocks, starting at the next block boundary.
+         *
+         * @return the index of the first reserved block
+         */
+        uint64_t reserve_blocks(uint64_t n) {
+            const uint64_t first = (position + 3) / 4;
+            position = (first + n) * 4;
+            return first;
+        }
+
+        /**
+         * @return a generator over another stream of the same seed
+         */
+        Philox split(uint64_t stream) const {
+            return Philox(key, stream);
+        }
+
+        /**
+         * @brief Philox4x32 with 10 rounds.
+         */
+        static Block philox(Block ctr, uint64_t seed) {
+            uint32_t k0 = static_cast<uint32_t>(seed), k1 = static_cast<uint32_t>(seed >> 32);
+            for (int r = 0; r < 10; ++r) {
+                if (r > 0) {
+                    k0 += 0x9E3779B9u;
+                    k1 += 0xBB67AE85u;
+                }
+                const uint64_t p0 = uint64_t(0xD2511F53u) * ctr[0];
+                const uint64_t p1 = uint64_t(0xCD9E8D57u) * ctr[2];
+                ctr = {static_cast<uint32_t>(p1 >> 32) ^ ctr[1] ^ k0, static_cast<uint32_t>(p1),
+                       static_cast<uint32_t>(p0 >> 32) ^ ctr[3] ^ k1, static_cast<uint32_t>(p0)};
+            }
+            return ctr;
+        }
+
+    private:
+        static constexpr uint64_t NO_BLOCK = std::numeric_limits<uint64_t>::max();
+
+        uint64_t key;
+        uint64_t stream_id;
+        uint64_t position;
+
+        uint64_t cached_index = NO_BLOCK;
+        Block cache{};
+    };
+
+    /**
+     * @brief Maps 64 random bits to [0, 1).
+     */
+    template<typename T>
+    inline T to_unit(uint64_t bits) {
+        if constexpr (std::numeric_limits<T>::digits <= 24) {
+            return static_cast<T>(bits >> 40) * (T(1) / T(1 << 24));
+        } else {
+            return static_cast<T>(static_cast<double>(bits >> 11) * 0x1.0p-53);
+        }
+    }
+
+    /**
+     * @brief Two standard normal samples from a block of random bits (Box-Muller).
+     */
+    template<typename T>
+    inline std::array<T, 2> box_muller(const Philox::Block &b) {
+        const uint64_t x = (uint64_t(b[1]) << 32) | b[0];
+        const uint64_t y = (uint64_t(b[3]) << 32) | b[2];
+        // u1 in (0, 1] so that the logarithm is finite
+        const double u1 = static_cast<double>((x >> 11) + 1) * 0x1.0p-53;
+        const double u2 = static_cast<double>(y >> 11) * 0x1.0p-53;
+        const double r = std::sqrt(-2.0 * std::log(u1));
+        const double theta = 2.0 * std::numbers::pi * u2;
+        return {static_cast<T>(r * std::cos(theta)), static_cast<T>(r * std::sin(theta))};
+    }
+
+}
+
+#endif
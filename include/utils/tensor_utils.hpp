@@ -5,11 +5,22 @@
 #include <vector>
 #include <random>
 #include "core/tensor_core.hpp"
+#include "parallel/thread_pool.hpp"
+#include "utils/random.hpp"
 
 namespace tensor {
 
-    inline std::mt19937 &global_rng() {
-        static std::mt19937 gen{std::random_device{}()};
+    /**
+     * @brief Returns the global random number generator.
+     *
+     * A counter-based generator (see Philox): uniform, normal and random_perm reserve
+     * a range of counters and fill it in parallel, so their results only depend on
+     * the seed and on the position of the generator, not on the number of threads.
+     * The position can be saved with get_offset() and restored with set_offset()
+     * to resume a run.
+     */
+    inline Philox &global_rng() {
+        static Philox gen{std::random_device{}()};
         return gen;
     }
 
@@ -72,9 +83,18 @@ namespace tensor {
     inline std::shared_ptr<Tensor<T>>
     uniform(const typename Tensor<T>::Shape &shape, T low = T(0), T high = T(1), bool requires_grad = false) {
         std::vector<T> data(std::accumulate(shape.begin(), shape.end(), 1, std::multiplies<size_t>()));
-        std::uniform_real_distribution<T> dist(low, high);
+        // Every block of random bits gives two elements
         auto &gen = global_rng();
-        for (auto &x: data) x = dist(gen);
+        const size_t n_blocks = (data.size() + 1) / 2;
+        const uint64_t first = gen.reserve_blocks(n_blocks);
+        parallel::parallel_for(0, n_blocks, [&](size_t lo, size_t hi) {
+            for (size_t b = lo; b < hi; ++b) {
+                const auto bits = gen.block(first + b);
+                data[2 * b] = low + (high - low) * to_unit<T>((uint64_t(bits[1]) << 32) | bits[0]);
+                if (2 * b + 1 < data.size())
+                    data[2 * b + 1] = low + (high - low) * to_unit<T>((uint64_t(bits[3]) << 32) | bits[2]);
+            }
+        });
         return make_tensor<T>(shape, data, requires_grad);
     }
 
@@ -95,9 +115,17 @@ namespace tensor {
     inline std::shared_ptr<Tensor<T>>
     normal(const typename Tensor<T>::Shape &shape, T mean = T(0), T stddev = T(1), bool requires_grad = false) {
         std::vector<T> data(std::accumulate(shape.begin(), shape.end(), 1, std::multiplies<size_t>()));
-        std::normal_distribution<T> dist(mean, stddev);
+        // Every block of random bits gives two elements
         auto &gen = global_rng();
-        for (auto &x: data) x = dist(gen);
+        const size_t n_blocks = (data.size() + 1) / 2;
+        const uint64_t first = gen.reserve_blocks(n_blocks);
+        parallel::parallel_for(0, n_blocks, [&](size_t lo, size_t hi) {
+            for (size_t b = lo; b < hi; ++b) {
+                const auto z = box_muller<T>(gen.block(first + b));
+                data[2 * b] = mean + stddev * z[0];
+                if (2 * b + 1 < data.size()) data[2 * b + 1] = mean + stddev * z[1];
+            }
+        });
         return make_tensor<T>(shape, data, requires_grad);
     }
 
@@ -117,12 +145,78 @@ namespace tensor {
         return make_tensor<T>(shape, data, requires_grad);
     }
 
+    /**
+     * @brief Converts a tensor to another element type, e.g. to dual numbers with zero tangents.
+     */
+    template<typename D, typename T>
+    inline std::shared_ptr<Tensor<D>> lift(const std::shared_ptr<Tensor<T>> &t, bool requires_grad = false) {
+        std::vector<D> data(t->data.size());
+        for (size_t i = 0; i < data.size(); ++i) data[i] = D(t->data[i]);
+        return make_tensor<D>(t->shape, data, requires_grad);
+    }
+
+    /**
+     * @brief Seeds every input coordinate as an independent forward-mode direction.
+     *
+     * Element (i, k) of x, of shape (M, N), gets tangent e_k: a function of the
+     * result carries its N partial derivatives with respect to the row it reads.
+     */
+    template<size_t N, typename T>
+    inline std::shared_ptr<Tensor<Dual<T, N>>> seed_jacobian(const std::shared_ptr<Tensor<T>> &x) {
+        if (x->shape.size() != 2 || x->shape[1] != N)
+            throw std::runtime_error("seed_jacobian expects an input of shape (M, N)");
+        std::vector<Dual<T, N>> data(x->data.size());
+        for (size_t i = 0; i < data.size(); ++i) data[i] = Dual<T, N>::variable(x->data[i], i % N);
+        return make_tensor<Dual<T, N>>(x->shape, data);
+    }
+
+    /**
+     * @brief Seeds input coordinate k of every row on both levels of a hyper-dual number.
+     *
+     * For u = f(x), tangent(primal(u), 0) and tangent(tangent(u, 0), 0) are
+     * du/dx_k and d^2u/dx_k^2.
+     */
+    template<typename T>
+    inline std::shared_ptr<Tensor<HyperDual<T>>> seed_direction(const std::shared_ptr<Tensor<T>> &x, size_t k) {
+        if (x->shape.size() != 2 || k >= x->shape[1])
+            throw std::runtime_error("seed_direction expects an input of shape (M, d) and k < d");
+        const size_t d = x->shape[1];
+        std::vector<HyperDual<T>> data(x->data.size());
+        for (size_t i = 0; i < data.size(); ++i) {
+            const T dir = i % d == k ? T(1) : T(0);
+            data[i] = HyperDual<T>(Dual<T, 1>(x->data[i], {dir}), {Dual<T, 1>(dir)});
+        }
+        return make_tensor<HyperDual<T>>(x->shape, data);
+    }
+
+    /**
+     * @brief Value part of a dual tensor.
+     */
+    template<typename T, size_t N>
+    inline std::shared_ptr<Tensor<T>> primal(const std::shared_ptr<Tensor<Dual<T, N>>> &t) {
+        std::vector<T> data(t->data.size());
+        for (size_t i = 0; i < data.size(); ++i) data[i] = t->data[i].val;
+        return make_tensor<T>(t->shape, data);
+    }
+
+    /**
+     * @brief Tangent k of a dual tensor.
+     */
+    template<typename T, size_t N>
+    inline std::shared_ptr<Tensor<T>> tangent(const std::shared_ptr<Tensor<Dual<T, N>>> &t, size_t k) {
+        if (k >= N) throw std::runtime_error("tangent index out of range");
+        std::vector<T> data(t->data.size());
+        for (size_t i = 0; i < data.size(); ++i) data[i] = t->data[i].eps[k];
+        return make_tensor<T>(t->shape, data);
+    }
+
     /**
      * @brief Generate a random permutation of indices [0, n).
      *
      * Returns a vector containing a uniformly random permutation of the integers
      * from 0 to n-1. The permutation is generated using the Fisher–Yates shuffle
-     * and the global random number generator.
+     * and the global random number generator; the random draws are generated in
+     * parallel, while the swaps are applied serially.
      *
      * @param n Number of elements in the permutation.
      * @return A vector of size n containing a random permutation of [0, n).
@@ -130,11 +224,25 @@ namespace tensor {
     inline std::vector<size_t> random_perm(size_t n) {
         std::vector<size_t> perm(n);
         for (size_t i = 0; i < n; ++i) perm[i] = i;
+        if (n < 2) return perm;
+
+        // 64 random bits per swap, two swaps per block
+        auto &gen = global_rng();
+        std::vector<uint64_t> draws(n - 1);
+        const size_t n_blocks = n / 2;
+        const uint64_t first = gen.reserve_blocks(n_blocks);
+        parallel::parallel_for(0, n_blocks, [&](size_t lo, size_t hi) {
+            for (size_t b = lo; b < hi; ++b) {
+                const auto bits = gen.block(first + b);
+                draws[2 * b] = (uint64_t(bits[1]) << 32) | bits[0];
+                if (2 * b + 1 < draws.size()) draws[2 * b + 1] = (uint64_t(bits[3]) << 32) | bits[2];
+            }
+        });
 
-        auto& gen = global_rng();
         for (size_t i = n - 1; i > 0; --i) {
-            std::uniform_int_distribution<size_t> dist(0, i);
-            std::swap(perm[i], perm[dist(gen)]);
+            // Maps the draw to [0, i] with a multiply-shift (bias below 2^-32 for any practical n)
+            const size_t j = static_cast<size_t>((static_cast<unsigned __int128>(draws[n - 1 - i]) * (i + 1)) >> 64);
+            std::swap(perm[i], perm[j]);
         }
         return perm;
     }
@@ -1,71 +1,15 @@
 #include <iostream>
 #include "tensor.hpp"
 #include <cmath>
+#include <chrono>
 #include "extra/GetPot.hpp"
 
 using namespace tensor::ops;
 
-/**
- * @brief Simple feedforward neural network implementing the Model interface.
- *
- * This class demonstrates a standard fully connected feedforward network
- * with multiple hidden layers and a single output. It follows the
- * `tensor::nn::Model` interface, exposing a forward pass (`operator()`)
- * and a method to access trainable parameters (`getParams()`).
- *
- * Key points for implementing custom models:
- * - Always inherit from `tensor::nn::Model<T>`.
- * - Implement the forward pass via `operator()(const TensorS<T>& input)`.
- * - Expose all trainable parameters using `getParams()` so that optimizers
- *   like Adam can access and update them automatically.
- * - Maintain proper gradient tracking for all parameters.
- *
- * This class may be implemented in header files in the future.
- *
- **/
-template <Numeric T>
-struct FeedForwardNN : tensor::nn::Model<T> {
-
-    tensor::nn::Linear<T> linear1;
-    tensor::nn::Linear<T> linear2;
-    tensor::nn::Linear<T> linear3;
-    tensor::nn::Linear<T> linear4;
-    tensor::nn::Linear<T> linear5;
-
-    FeedForwardNN(Tensor<T>::shape_type hidden_size) 
-        : linear1(2, hidden_size, 0.1),
-          linear2(hidden_size, hidden_size, 0.1),
-          linear3(hidden_size, hidden_size, 0.1),
-          linear4(hidden_size, hidden_size, 0.1),
-          linear5(hidden_size, 1, 0.1)
-          {}
-
-    TensorS<T> operator()(const TensorS<T> &input) const override {
-        return linear5(tanh(linear4(tanh(linear3(tanh(linear2(tanh(linear1(input)))))))));
-    }
-
-    std::vector<TensorS<T>> getParams() const override {
-        std::vector<TensorS<T>> params;
-
-        auto append = [&](const std::vector<TensorS<T>>& p) {
-            params.insert(params.end(), p.begin(), p.end());
-        };
-
-        append(linear1.getParams());
-        append(linear2.getParams());
-        append(linear3.getParams());
-        append(linear4.getParams());
-        append(linear5.getParams());
-
-        return params;
-    }
-
-};
-
 /**
  * Demonstrates a physics-informed neural network to solve a 2d Laplace problem.
  *
- * This example uses a simple feedforward neural network implemented with the tensor library.
+ * This example uses a fully connected tanh network of the tensor library (tensor::nn::MLP).
  * It approximates the solution to a 2d Laplace problem on a domain [-1, 1] x [-1, 1] with Dirichlet
  * boundary conditions.
  *
@@ -75,7 +19,8 @@ struct FeedForwardNN : tensor::nn::Model<T> {
  * 3. Creates the training dataset of Nc collocation points and Nb boundary points.
  * 4. Initializes the neural network parameters and define the forward model.
  * 5. Defines the mean squared error loss and PDE loss.
- * 6. Uses the Adam optimizer to train the network.
+ * 6. Uses the Adam optimizer to train the network, optionally followed by L-BFGS iterations to
+ *    refine the solution.
  * 7. Generates a grid of points for validation and post-processing data for the python notebook.
  */
 int main(int argc, char* argv[]) {
@@ -100,8 +45,19 @@ int main(int argc, char* argv[]) {
     int epochs = cmd("--epochs", parser("epochs", 1000));
     T lr = cmd("--lr", parser("learning_rate", 2e-4));
 
+    // L-BFGS steps run after the Adam epochs (each one up to 20 iterations)
+    int lbfgs_epochs = cmd("--lbfgs_epochs", parser("lbfgs_epochs", 0));
+
+    // Number of shards of the dataset for data-parallel training (1 disables it)
+    size_t num_shards = cmd("--shards", parser("num_shards", 1));
+    num_shards = std::clamp<size_t>(num_shards, 1, std::min(N_collocation, N_boundaries));
+
+    // Bit-wise reproducible results for any number of threads
+    bool deterministic = cmd.search("--deterministic") || parser("deterministic", 0) != 0;
+    tensor::parallel::set_deterministic(deterministic);
+
     bool verbose = cmd.search("--verbose");
-    int OUTPUT_INTERVAL = verbose ? 1 : epochs / 10;
+    int OUTPUT_INTERVAL = verbose ? 1 : std::max(1, (epochs + lbfgs_epochs) / 10);
 
     std::cout << "========================================\n";
     std::cout << "Running 2D Laplace PINN problem\n";
@@ -112,6 +68,8 @@ int main(int argc, char* argv[]) {
     std::cout << "Loss weights: lambda_pde = " << lambda_pde
               << ", lambda_boundary = " << lambda_boundary << "\n";
     std::cout << "Training epochs: " << epochs << "\n";
+    std::cout << "L-BFGS epochs: " << lbfgs_epochs << "\n";
+    std::cout << "Data-parallel shards: " << num_shards << "\n";
     std::cout << "========================================\n";
 
     tensor::set_seed(32);
@@ -123,7 +81,7 @@ int main(int argc, char* argv[]) {
 
     // Dataset
     // Collection points uniformly sampled in [-1, 1] x [-1, 1]
-    auto x = tensor::uniform<T>({N_collocation, 2}, -1.f, 1.f, true);
+    auto x = tensor::uniform<T>({N_collocation, 2}, -1.f, 1.f, false);
 
     size_t Nb_side = N_boundaries / 4;
     auto x_boundaries = tensor::uniform<T>({N_boundaries, 2}, -1.f, 1.f, false);
@@ -152,17 +110,30 @@ int main(int argc, char* argv[]) {
         );
     }
 
-    // Neural network
-    FeedForwardNN<T> model(hidden_size);
+    // Neural network: four hidden layers of hidden_size neurons
+    const std::vector<size_t> widths{2, hidden_size, hidden_size, hidden_size, hidden_size, 1};
+    tensor::nn::MLP<T> model(widths, 0.1);
 
     // Lambda function to compute MSE loss
     auto mse_loss = [](auto pred, auto target) {
-        return mean(pow(pred + (-1.)*target, 2));
+        return mean(pow(pred - target, 2));
     };
 
+    // Data-parallel training: every shard of the dataset is processed by its own model replica
+    std::unique_ptr<tensor::parallel::DataParallel<T>> data_parallel;
+    if (num_shards > 1) {
+        data_parallel = std::make_unique<tensor::parallel::DataParallel<T>>(
+                model,
+                [&widths]() { return std::make_unique<tensor::nn::MLP<T>>(widths, 0.1); },
+                num_shards
+        );
+    }
+    std::vector<T> pde_parts(num_shards), boundary_parts(num_shards);
+
     // Adam init
     T beta1 = 0.9, beta2 = 0.999, eps = 1e-8, weight_decay = 1e-3;
     auto optim = tensor::optim::Adam<T>(model.getParams(), lr, beta1, beta2, eps, weight_decay);
+    auto lbfgs = tensor::optim::LBFGS<T>(model.getParams());
 
     // File where to store the history of the training
     std::ofstream history("history.csv");
@@ -172,59 +143,102 @@ int main(int argc, char* argv[]) {
     history << "history,pde_loss,boundary_loss,total_loss\n";
 
     // Training loop
-    for (int epoch = 0; epoch < epochs; ++epoch) {
-        optim.zero_grad();
-        x->zero_grad();
+    auto start = std::chrono::steady_clock::now();
+    for (int epoch = 0; epoch < epochs + lbfgs_epochs; ++epoch) {
 
+        // Shuffled views of the train dataset, read through index lists
         auto perm = tensor::random_perm(N_collocation);
-        x->permute_rows(perm);   // Permuting the rows of the train dataset
+        auto perm_bound = tensor::random_perm(N_boundaries);
+
+        // Computes the loss terms of one shard of the shuffled dataset
+        auto shard_loss = [&](const tensor::nn::Model<T> &net, size_t shard, size_t num_shards) {
+            auto [lo, hi] = tensor::parallel::shard_range(N_collocation, shard, num_shards);
+            auto rows = index_select(x, 0, std::vector<size_t>(perm.begin() + lo, perm.begin() + hi));
+
+            // PDE residual d^2 u / dx^2 + d^2 u / dy^2, computed exactly in one forward pass
+            // and attached to the graph, so the same backward trains it
+            auto laplacian = tensor::nn::laplacian(net, rows);
 
-        // Forward pass: computes u'(x)
-        auto pred = model(x);
-        pred->backward();
+            auto pde_loss = mean(pow(laplacian, 2)) * (T(hi - lo) / N_collocation);
+            pde_loss->metadata.name = "pde_loss";
 
-        // Computes PDE_loss as: d^2 u' / dx^2 + d^2 u' / dy^2
-        auto laplacian = tensor::zeros<T>({N_collocation, 1}, false);
-        for (size_t i = 0; i < N_collocation; ++i)
-            laplacian->data[i] = x->hess[i*2] + x->hess[i*2+1];
+            // Boundary loss
+            auto [b_lo, b_hi] = tensor::parallel::shard_range(N_boundaries, shard, num_shards);
+            std::vector<size_t> rows_bound(perm_bound.begin() + b_lo, perm_bound.begin() + b_hi);
 
-        auto pde_loss = mean(pow(laplacian, 2));
-        pde_loss->metadata.name = "pde_loss";
-        
-        // Boundary loss
-        auto perm_bound = tensor::random_perm(N_boundaries); // Permuting the rows of the train dataset
-        x_boundaries->permute_rows(perm_bound);
-        boundary_target->permute_rows(perm_bound);
+            auto pred_bound = net(index_select(x_boundaries, 0, rows_bound));
+            auto boundary_loss = mse_loss(pred_bound, index_select(boundary_target, 0, rows_bound))
+                                 * (T(b_hi - b_lo) / N_boundaries);
 
-        auto pred_bound = model(x_boundaries);
-        auto boundary_loss = mse_loss(pred_bound, boundary_target);
+            pde_parts[shard] = pde_loss->data[0];
+            boundary_parts[shard] = boundary_loss->data[0];
 
-        // Total loss
-        auto total_loss = lambda_pde * pde_loss + lambda_boundary * boundary_loss;
-        total_loss->metadata.name = "Total loss";
+            // Total loss
+            auto total_loss = lambda_pde * pde_loss + lambda_boundary * boundary_loss;
+            total_loss->metadata.name = "Total loss";
+            return total_loss;
+        };
+
+        // Backpropagation, the loss terms of the evaluation are stored in the shard parts
+        auto compute_gradients = [&]() {
+            if (num_shards == 1) {
+                // (the PDE and boundary branches are differentiated concurrently)
+                auto total_loss = shard_loss(model, 0, 1);
+                total_loss->backward(true, true);
+            } else {
+                data_parallel->compute_gradients(shard_loss);
+            }
+        };
 
-        // Backpropagation and parameter update
-        optim.zero_grad();
-        total_loss->backward();
-        optim.step();
+        T pde_loss = 0, boundary_loss = 0;
+        auto sum_parts = [&]() {
+            pde_loss = boundary_loss = 0;
+            for (size_t s = 0; s < num_shards; ++s) {
+                pde_loss += pde_parts[s];
+                boundary_loss += boundary_parts[s];
+            }
+            return lambda_pde * pde_loss + lambda_boundary * boundary_loss;
+        };
+
+        // Parameter update
+        if (epoch < epochs) {
+            optim.zero_grad();
+            compute_gradients();
+            optim.step();
+        } else {
+            // The closure may be evaluated several times by the line search
+            lbfgs.step([&]() {
+                compute_gradients();
+                return sum_parts();
+            });
+            // The last evaluation may be a rejected trial point: the logged terms are the ones
+            // of the accepted parameters, recomputed by a forward pass
+            for (size_t s = 0; s < num_shards; ++s) shard_loss(model, s, num_shards);
+        }
+        T total_loss = sum_parts();
 
         // Logging
         if (epoch % OUTPUT_INTERVAL == 0) {
             std::cout << "Epoch: " << epoch << ", PDE loss: "
-                      << pde_loss->data[0] << ", Data loss: "
-                      << boundary_loss->data[0] << ", Total loss: "
-                      << total_loss->data[0] << std::endl;
+                      << pde_loss << ", Data loss: "
+                      << boundary_loss << ", Total loss: "
+                      << total_loss << std::endl;
         }
 
         history << epoch << ","
-                << pde_loss->data[0] << ","
-                << boundary_loss->data[0] << ","
-                << total_loss->data[0] << std::endl;
+                << pde_loss << ","
+                << boundary_loss << ","
+                << total_loss << std::endl;
 
     }
 
     history.close();
 
+    double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+    std::cout << "Training time: " << seconds << " s (" << (epochs + lbfgs_epochs) / seconds
+              << " epochs/s, " << tensor::parallel::get_num_threads() << " threads"
+              << (deterministic ? ", deterministic" : "") << ")" << std::endl;
+
     // Validation step
     size_t n = 100;
     size_t N = n*n;
@@ -42,4 +42,35 @@ int main() {
         
     }
 
-}
\ No newline at end of file
+    {
+        // First and second derivatives against central finite differences
+        using D = double;
+        std::vector<D> points{-2.0, -0.3, 0.0, 0.7, 1.9};
+        const D h = 1e-4;
+
+        auto check = [&](auto act, auto f) {
+            auto z = std::make_shared<Tensor<D>>(Tensor<D>::Shape{points.size()}, points, true);
+            auto y = act(z);
+            y->backward();
+            for (size_t i = 0; i < points.size(); ++i) {
+                D x0 = points[i];
+                D d1 = (f(x0 + h) - f(x0 - h)) / (2 * h);
+                D d2 = (f(x0 + h) - 2 * f(x0) + f(x0 - h)) / (h * h);
+                assert(approx(y->data[i], f(x0)));
+                assert(approx(z->grad[i], d1, 1e-6));
+                assert(approx(z->hess[i], d2, 1e-5));
+            }
+        };
+
+        auto sig = [](D x) { return 1.0 / (1.0 + std::exp(-x)); };
+        check([](auto t) { return sin(t); }, [](D x) { return std::sin(x); });
+        check([](auto t) { return sigmoid(t); }, sig);
+        check([](auto t) { return softplus(t); }, [](D x) { return std::log(1.0 + std::exp(x)); });
+        check([](auto t) { return gelu(t); }, [](D x) { return 0.5 * x * (1.0 + std::erf(x / std::sqrt(2.0))); });
+        check([&](auto t) { return swish(t); }, [&](D x) { return x * sig(x); });
+        check([](auto t) { return tanh(t); }, [](D x) { return std::tanh(x); });
+
+        std::cout << "Smooth activations test passed" << std::endl;
+    }
+
+}
@@ -0,0 +1,101 @@
+#include <iostream>
+#include <cassert>
+#include "tensor.hpp"
+
+bool approx(double a, double b, double tol = 1e-10) {
+    return std::abs(a - b) < tol;
+}
+
+using T = double;
+
+/// Layer widths of the network of the tests
+const std::vector<size_t> widths{2, 16, 1};
+
+int main() {
+    using namespace tensor::ops;
+    tensor::set_seed(50);
+
+    // Ill-conditioned separable quadratic sum(a * x^2) / 2, whose Hessian diagonal is a
+    auto a = std::make_shared<Tensor<T>>(Tensor<T>::Shape{4}, std::vector<T>{1, 10, 100, 1000});
+    auto quadratic = [&](const TensorS<T> &x) {
+        return sum(a * pow(x, 2)) * 0.5;
+    };
+
+    {
+        // The first step with unit learning rate is the Newton step
+        auto x = std::make_shared<Tensor<T>>(Tensor<T>::Shape{4}, std::vector<T>{1, -2, 3, -4}, true);
+        tensor::optim::AdaHessian<T> optim({x}, 1.0, 0.9, 0.999, 1e-12, 0.0);
+        quadratic(x)->backward();
+        for (size_t i = 0; i < 4; ++i) assert(approx(x->hess[i], a->data[i]));
+        optim.step();
+        for (auto e: x->data) assert(approx(e, 0.0));
+
+        // Gradients and diagonals are cleared
+        optim.zero_grad();
+        for (size_t i = 0; i < 4; ++i) assert(x->grad[i] == 0 && x->hess[i] == 0);
+    }
+
+    {
+        // Block averaging, decoupled weight decay and hessian power against a direct computation
+        const T lr = 0.1, wd = 0.01, k = 0.5, eps = 1e-4;
+        auto x = std::make_shared<Tensor<T>>(Tensor<T>::Shape{4}, std::vector<T>{1, -2, 3, -4}, true);
+        tensor::optim::AdaHessian<T> optim({x}, lr, 0.9, 0.999, eps, wd, k, 3);
+        auto x0 = x->data;
+        quadratic(x)->backward();
+        const T D[4] = {37, 37, 37, 1000};
+        std::vector<T> expected(4);
+        for (size_t i = 0; i < 4; ++i) {
+            T m_hat = x->grad[i], v_hat = D[i] * D[i];
+            expected[i] = x0[i] - lr * (m_hat / (std::pow(std::sqrt(v_hat), k) + eps) + wd * x0[i]);
+        }
+        optim.step();
+        for (size_t i = 0; i < 4; ++i) assert(approx(x->data[i], expected[i]));
+    }
+
+    {
+        // Reaches a tolerance on the quadratic in fewer steps than Adam with the same learning rate
+        auto steps_to = [&](tensor::optim::Optimizer<T> &optim, const TensorS<T> &x) {
+            for (int s = 1; s <= 5000; ++s) {
+                optim.zero_grad();
+                auto loss = quadratic(x);
+                if (loss->data[0] < 1e-6) return s;
+                loss->backward();
+                optim.step();
+            }
+            return 5001;
+        };
+        auto x1 = std::make_shared<Tensor<T>>(Tensor<T>::Shape{4}, std::vector<T>{1, -2, 3, -4}, true);
+        auto x2 = std::make_shared<Tensor<T>>(Tensor<T>::Shape{4}, std::vector<T>{1, -2, 3, -4}, true);
+        tensor::optim::Adam<T> adam({x1}, 0.05, 0.9, 0.999, 1e-8, 0.0);
+        tensor::optim::AdaHessian<T> adahessian({x2}, 0.05, 0.9, 0.999, 1e-8, 0.0);
+        assert(steps_to(adahessian, x2) < steps_to(adam, x1));
+    }
+
+    {
+        // Training a network with the diagonal propagated by backward
+        auto x = tensor::uniform<T>({64, 2}, -1.0, 1.0);
+        auto y = tensor::zeros<T>({64, 1});
+        for (size_t i = 0; i < 64; ++i) y->data[i] = x->data[2 * i] * x->data[2 * i + 1];
+        tensor::nn::MLP<T> net(widths, 0.8);
+        tensor::optim::AdaHessian<T> optim(net.getParams(), 0.05, 0.9, 0.999, 1e-4, 0.0, 1.0, 4);
+        T first = 0, last = 0;
+        for (int s = 0; s < 200; ++s) {
+            optim.zero_grad();
+            auto loss = mean(pow(net(x) - y, 2));
+            if (s == 0) first = loss->data[0];
+            last = loss->data[0];
+            loss->backward();
+            optim.step();
+        }
+        assert(last < 0.1 * first);
+    }
+
+    {
+        bool thrown = false;
+        try { tensor::optim::AdaHessian<T>({}, 0.1, 0.9, 0.999, 1e-8, 0.0, 1.0, 0); } catch (const std::runtime_error &) { thrown = true; }
+        assert(thrown);
+    }
+
+    std::cout << "AdaHessian tests passed!" << std::endl;
+    return 0;
+}
@@ -0,0 +1,84 @@
+#include <iostream>
+#include <memory>
+#include <cassert>
+#include "tensor.hpp"
+
+bool approx(double a, double b, double tol = 1e-6) {
+    return std::abs(a - b) < tol;
+}
+
+int main() {
+    using namespace tensor::ops;
+    using T = double;
+
+    {
+        // Per-feature scaling: (3, 2) * (2)
+        auto x = std::make_shared<Tensor<T>>(
+                Tensor<T>::Shape{3, 2},
+                std::vector<T>{1.0, 2.0, 3.0, 4.0, 5.0, 6.0},
+                true
+        );
+        auto w = std::make_shared<Tensor<T>>(
+                Tensor<T>::Shape{2},
+                std::vector<T>{2.0, -1.0},
+                true
+        );
+
+        auto y = x * w;
+        assert((y->shape == Tensor<T>::Shape{3, 2}));
+        y->backward();
+
+        std::vector<T> expected{2.0, -2.0, 6.0, -4.0, 10.0, -6.0};
+        for (size_t i = 0; i < 6; ++i) assert(approx(y->data[i], expected[i]));
+
+        // Gradient of the broadcast operand is reduced over the rows
+        assert(approx(w->grad[0], 9.0));
+        assert(approx(w->grad[1], 12.0));
+        assert(approx(w->hess[0], 0.0));
+        assert(approx(x->grad[0], 2.0));
+        assert(approx(x->grad[1], -1.0));
+        assert(approx(x->hess[1], 0.0));
+    }
+
+    {
+        // Outer sum: (3, 1) + (1, 2)
+        auto a = std::make_shared<Tensor<T>>(Tensor<T>::Shape{3, 1}, std::vector<T>{1.0, 2.0, 3.0}, true);
+        auto b = std::make_shared<Tensor<T>>(Tensor<T>::Shape{1, 2}, std::vector<T>{10.0, 20.0}, true);
+
+        auto y = a + b;
+        assert((y->shape == Tensor<T>::Shape{3, 2}));
+        y->backward();
+
+        std::vector<T> expected{11.0, 21.0, 12.0, 22.0, 13.0, 23.0};
+        for (size_t i = 0; i < 6; ++i) assert(approx(y->data[i], expected[i]));
+        for (size_t i = 0; i < 3; ++i) assert(approx(a->grad[i], 2.0));
+        for (size_t i = 0; i < 2; ++i) assert(approx(b->grad[i], 3.0));
+    }
+
+    {
+        // Per-sample weights on a 3D tensor: (2, 2, 2) * (2, 1, 1)
+        auto x = tensor::ones<T>({2, 2, 2}, true);
+        auto w = std::make_shared<Tensor<T>>(Tensor<T>::Shape{2, 1, 1}, std::vector<T>{3.0, 4.0}, true);
+
+        auto y = sum(x * w);
+        y->backward();
+
+        assert(approx(y->data[0], 28.0));
+        assert(approx(w->grad[0], 4.0));
+        assert(approx(w->grad[1], 4.0));
+        assert(approx(x->grad[0], 3.0));
+        assert(approx(x->grad[7], 4.0));
+    }
+
+    {
+        bool thrown = false;
+        try {
+            auto y = tensor::ones<T>({3, 2}) + tensor::ones<T>({3});
+        } catch (const std::runtime_error &) {
+            thrown = true;
+        }
+        assert(thrown);
+    }
+
+    std::cout << "Broadcast tests passed!\n";
+}
@@ -0,0 +1,93 @@
+#include <iostream>
+#include <memory>
+#include <cassert>
+#include "tensor.hpp"
+
+bool approx(double a, double b, double tol = 1e-9) {
+    return std::abs(a - b) < tol;
+}
+
+using T = double;
+
+/// Layer widths of the network of the tests
+const std::vector<size_t> widths{2, 8, 1};
+
+int main() {
+    using namespace tensor::ops;
+    namespace par = tensor::parallel;
+
+    {
+        // Shards cover the range with sizes differing by at most one
+        size_t covered = 0;
+        for (size_t s = 0; s < 3; ++s) {
+            auto [lo, hi] = par::shard_range(10, s, 3);
+            assert(lo == covered);
+            assert(hi - lo == (s == 0 ? 4u : 3u));
+            covered = hi;
+        }
+        assert(covered == 10);
+    }
+
+    tensor::set_seed(3);
+    const size_t N = 100;
+    auto x = tensor::uniform<T>({N, 2}, -1.0, 1.0);
+    auto y = tensor::uniform<T>({N, 1}, -1.0, 1.0);
+
+    auto loss_fn = [&](const tensor::nn::Model<T> &net, size_t shard, size_t num_shards) {
+        auto [lo, hi] = par::shard_range(N, shard, num_shards);
+        std::vector<size_t> rows;
+        for (size_t i = lo; i < hi; ++i) rows.push_back(i);
+        auto pred = net(index_select(x, 0, rows));
+        return mean(pow(pred - index_select(y, 0, rows), 2)) * (T(hi - lo) / N);
+    };
+
+    auto gradients = [&](size_t threads, size_t shards) {
+        par::set_num_threads(threads);
+        tensor::set_seed(5);
+        tensor::nn::MLP<T> model(widths);
+        std::vector<T> result;
+        if (shards == 0) {
+            auto loss = loss_fn(model, 0, 1);
+            loss->backward();
+            result.push_back(loss->data[0]);
+        } else {
+            par::DataParallel<T> dp(model, []() { return std::make_unique<tensor::nn::MLP<T>>(widths); }, shards);
+            result.push_back(dp.compute_gradients(loss_fn));
+        }
+        for (auto &p: model.getParams()) {
+            result.insert(result.end(), p->grad.begin(), p->grad.end());
+            result.insert(result.end(), p->hess.begin(), p->hess.end());
+        }
+        return result;
+    };
+
+    auto reference = gradients(1, 0);
+    auto serial = gradients(1, 5);
+    for (size_t threads: {2, 4}) {
+        // Bit-identical for a fixed number of shards
+        auto threaded = gradients(threads, 5);
+        for (size_t i = 0; i < serial.size(); ++i) assert(threaded[i] == serial[i]);
+    }
+    // Same gradients as the unsharded loss, up to rounding
+    for (size_t i = 0; i < serial.size(); ++i) assert(approx(serial[i], reference[i]));
+
+    {
+        // Plugs into the optimizers through the master parameters
+        tensor::nn::MLP<T> model(widths);
+        auto params = model.getParams();
+        auto before = params[0]->data;
+        tensor::optim::Adam<T> optim(params, 1e-2, 0.9, 0.999, 1e-8, 0.0);
+        par::DataParallel<T> dp(model, []() { return std::make_unique<tensor::nn::MLP<T>>(widths); }, 3);
+        T first = 0, last = 0;
+        for (int epoch = 0; epoch < 50; ++epoch) {
+            optim.zero_grad();
+            last = dp.compute_gradients(loss_fn);
+            if (epoch == 0) first = last;
+            optim.step();
+        }
+        assert(params[0]->data != before);
+        assert(last < first);
+    }
+
+    std::cout << "Data parallel tests passed!\n";
+}
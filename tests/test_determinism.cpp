@@ -0,0 +1,62 @@
+#include <iostream>
+#include <memory>
+#include <cassert>
+#include "tensor.hpp"
+
+using T = double;
+namespace par = tensor::parallel;
+
+/// Gradients and Hessians of a small two-branch PINN-like loss
+std::vector<T> run(size_t threads, bool parallel_backward)
+{
+    using namespace tensor::ops;
+    par::set_num_threads(threads);
+    par::set_grain_size(64);
+
+    tensor::set_seed(21);
+    auto W1 = tensor::normal<T>({2, 24}, 0.0, 1.0, true);
+    auto b1 = tensor::normal<T>({1, 24}, 0.0, 1.0, true);
+    auto W2 = tensor::normal<T>({24, 1}, 0.0, 1.0, true);
+    auto x = tensor::uniform<T>({3000, 2}, -1.0, 1.0, true);
+    auto xb = tensor::uniform<T>({500, 2}, -1.0, 1.0, false);
+
+    auto net = [&](TensorS<T> in) { return matmul(tanh(broadcast_add(matmul(in, W1), b1)), W2); };
+    auto loss = mean(pow(net(x), 2)) + sum(pow(net(xb) - 0.5, 2)) * 1e-3;
+    loss->backward(true, parallel_backward);
+
+    std::vector<T> result{loss->data[0]};
+    for (auto t: {W1, b1, W2, x}) {
+        result.insert(result.end(), t->grad.begin(), t->grad.end());
+        result.insert(result.end(), t->hess.begin(), t->hess.end());
+    }
+    return result;
+}
+
+int main() {
+    par::set_deterministic(true);
+    assert(par::deterministic());
+
+    // Bit-identical for any number of threads, for the serial and for the concurrent backward
+    auto reference = run(1, false);
+    auto concurrent = run(1, true);
+    assert(run(2, true) == concurrent);
+    for (size_t threads: {2, 3, 4}) {
+        assert(run(threads, false) == reference);
+        for (int rep = 0; rep < 5; ++rep) assert(run(threads, true) == concurrent);
+    }
+
+    {
+        // sum is reproducible for any number of threads
+        tensor::set_seed(4);
+        auto a = tensor::uniform<float>({100000}, -1.f, 1.f);
+        par::set_num_threads(1);
+        float expected = tensor::ops::sum(a)->data[0];
+        par::set_num_threads(4);
+        assert(tensor::ops::sum(a)->data[0] == expected);
+    }
+
+    par::set_deterministic(false);
+    assert(!par::deterministic());
+
+    std::cout << "Determinism tests passed!\n";
+}
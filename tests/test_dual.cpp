@@ -0,0 +1,107 @@
+#include <iostream>
+#include <cassert>
+#include "tensor.hpp"
+
+bool approx(double a, double b, double tol = 1e-9) {
+    return std::abs(a - b) < tol;
+}
+
+using D2 = tensor::Dual<double, 2>;
+using HD = tensor::HyperDual<double>;
+
+/// Same architecture on any element type
+const std::vector<size_t> widths{2, 8, 8, 1};
+
+int main() {
+    using namespace tensor::ops;
+
+    {
+        // Scalar rules: f(x) = x sin(x) / (1 + x^2) and its derivative
+        double x0 = 0.7;
+        auto x = tensor::Dual<double>::variable(x0, 0);
+        auto f = x * tensor::math::sin(x) / (1.0 + x * x);
+        double num = x0 * std::sin(x0), den = 1 + x0 * x0;
+        double df = ((std::sin(x0) + x0 * std::cos(x0)) * den - num * 2 * x0) / (den * den);
+        assert(approx(f.val, num / den));
+        assert(approx(f.eps[0], df));
+
+        // Hyper-dual numbers carry the second derivative: tanh'' = -2 t (1 - t^2)
+        HD h(tensor::Dual<double>(x0, {1.0}), {tensor::Dual<double>(1.0)});
+        auto t = tensor::math::tanh(h);
+        double tv = std::tanh(x0);
+        assert(approx(t.val.val, tv));
+        assert(approx(t.val.eps[0], 1 - tv * tv));
+        assert(approx(t.eps[0].val, 1 - tv * tv));
+        assert(approx(t.eps[0].eps[0], -2 * tv * (1 - tv * tv)));
+
+        // pow and exp, with mixed literals
+        auto p = tensor::math::pow(2.0 * x + 1.0, 3) + tensor::math::exp(x);
+        assert(approx(p.eps[0], 6 * std::pow(2 * x0 + 1, 2) + std::exp(x0)));
+    }
+
+    tensor::set_seed(11);
+    const size_t M = 16;
+    auto x = tensor::uniform<double>({M, 2}, -1.0, 1.0);
+
+    const auto act = tensor::nn::Activation::Sigmoid;
+    tensor::nn::MLP<double> net(widths, 0.8, act);
+    tensor::nn::MLP<D2> net_dual(widths, 0.8, act);
+    tensor::nn::MLP<HD> net_hyper(widths, 0.8, act);
+    tensor::nn::copy_params(net, net_dual);
+    tensor::nn::copy_params(net, net_hyper);
+
+    // Reference: exact Jacobian and Laplacian of the forward-Laplacian pass
+    auto ref = tensor::nn::forward_laplacian<double>(net, x);
+
+    {
+        // One forward pass on Dual<2> gives the value and both partial derivatives
+        auto out = net_dual(tensor::seed_jacobian<2>(x));
+        auto u = tensor::primal(out);
+        for (size_t i = 0; i < M; ++i) {
+            assert(approx(u->data[i], ref.u->data[i]));
+            for (size_t k = 0; k < 2; ++k)
+                assert(approx(tensor::tangent(out, k)->data[i], ref.J->data[k * M + i]));
+        }
+    }
+
+    {
+        // Hyper-dual passes along each axis give the second derivatives
+        std::vector<double> lap(M, 0.0);
+        for (size_t k = 0; k < 2; ++k) {
+            auto out = net_hyper(tensor::seed_direction(x, k));
+            auto d2 = tensor::tangent(tensor::tangent(out, 0), 0);
+            auto d1 = tensor::tangent(tensor::primal(out), 0);
+            for (size_t i = 0; i < M; ++i) {
+                lap[i] += d2->data[i];
+                assert(approx(d1->data[i], ref.J->data[k * M + i]));
+            }
+        }
+        for (size_t i = 0; i < M; ++i) assert(approx(lap[i], ref.L->data[i]));
+    }
+
+    {
+        // Batched products and reductions: d/dt of sum(bmm(A + t V, B)) = sum(bmm(V, B))
+        auto A = tensor::uniform<double>({3, 4, 5}, -1.0, 1.0);
+        auto V = tensor::uniform<double>({3, 4, 5}, -1.0, 1.0);
+        auto B = tensor::uniform<double>({5, 2}, -1.0, 1.0);
+        auto Ad = tensor::lift<tensor::Dual<double>>(A);
+        for (size_t i = 0; i < Ad->data.size(); ++i) Ad->data[i].eps[0] = V->data[i];
+        auto s = sum(bmm(Ad, tensor::lift<tensor::Dual<double>>(B)));
+        assert(approx(s->data[0].val, sum(bmm(A, B))->data[0]));
+        assert(approx(s->data[0].eps[0], sum(bmm(V, B))->data[0]));
+    }
+
+    {
+        // Reverse mode over dual numbers: the gradient of sum(x^3) is 3 x^2 and its tangent 6 x v
+        auto xd = tensor::lift<tensor::Dual<double>>(x, true);
+        for (size_t i = 0; i < xd->data.size(); ++i) xd->data[i].eps[0] = 1.0;
+        sum(pow(xd, 3))->backward();
+        for (size_t i = 0; i < xd->data.size(); ++i) {
+            assert(approx(xd->grad[i].val, 3 * x->data[i] * x->data[i]));
+            assert(approx(xd->grad[i].eps[0], 6 * x->data[i]));
+        }
+    }
+
+    std::cout << "Dual number tests passed!" << std::endl;
+    return 0;
+}
@@ -0,0 +1,96 @@
+#include <iostream>
+#include <cassert>
+#include "tensor.hpp"
+
+bool approx(double a, double b, double tol = 1e-12) {
+    return std::abs(a - b) < tol;
+}
+
+using T = double;
+
+/// Layer widths of the network of the tests
+const std::vector<size_t> widths{2, 10, 1};
+
+int main() {
+    using namespace tensor::ops;
+    tensor::set_seed(47);
+    auto x = tensor::uniform<T>({32, 2}, -1.0, 1.0);
+    auto y = tensor::uniform<T>({32, 1}, -1.0, 1.0);
+    const T lr = 1e-2, beta1 = 0.9, beta2 = 0.999, eps = 1e-8;
+
+    auto train = [&](tensor::nn::MLP<T> &net, tensor::optim::Optimizer<T> &optim, int steps) {
+        for (int s = 0; s < steps; ++s) {
+            optim.zero_grad();
+            mean(pow(net(x) - y, 2))->backward();
+            optim.step();
+        }
+    };
+
+    {
+        // Without weight decay the fused update is the one of Adam
+        tensor::nn::MLP<T> a(widths, 0.8), b(widths, 0.8);
+        tensor::nn::copy_params(a, b);
+        tensor::optim::Adam<T> adam(a.getParams(), lr, beta1, beta2, eps, 0.0);
+        tensor::optim::FusedAdam<T> fused(b.getParams(), lr, beta1, beta2, eps, 0.0);
+        assert(fused.size() == 2 * 10 + 10 + 10 + 1);
+        train(a, adam, 20);
+        train(b, fused, 20);
+        auto pa = a.getParams(), pb = b.getParams();
+        for (size_t i = 0; i < pa.size(); ++i)
+            for (size_t j = 0; j < pa[i]->data.size(); ++j) assert(approx(pa[i]->data[j], pb[i]->data[j]));
+    }
+
+    {
+        // Decoupled weight decay, against a reference AdamW loop
+        const T wd = 0.1;
+        tensor::nn::MLP<T> a(widths, 0.8), b(widths, 0.8);
+        tensor::nn::copy_params(a, b);
+        tensor::optim::FusedAdam<T> fused(a.getParams(), lr, beta1, beta2, eps, wd);
+
+        auto params = b.getParams();
+        std::vector<std::vector<T>> m, v;
+        for (auto &p: params) {
+            m.emplace_back(p->data.size(), T(0));
+            v.emplace_back(p->data.size(), T(0));
+        }
+        for (int t = 1; t <= 10; ++t) {
+            for (auto &p: params) p->zero_grad();
+            mean(pow(b(x) - y, 2))->backward();
+            for (size_t i = 0; i < params.size(); ++i) {
+                for (size_t j = 0; j < params[i]->data.size(); ++j) {
+                    T g = params[i]->grad[j];
+                    m[i][j] = beta1 * m[i][j] + (1 - beta1) * g;
+                    v[i][j] = beta2 * v[i][j] + (1 - beta2) * g * g;
+                    T step_size = lr * std::sqrt(1 - std::pow(beta2, t)) / (1 - std::pow(beta1, t));
+                    params[i]->data[j] -= lr * wd * params[i]->data[j] + step_size * m[i][j] / (std::sqrt(v[i][j]) + eps);
+                }
+            }
+        }
+        train(a, fused, 10);
+        auto pa = a.getParams();
+        for (size_t i = 0; i < pa.size(); ++i)
+            for (size_t j = 0; j < pa[i]->data.size(); ++j) assert(approx(pa[i]->data[j], params[i]->data[j], 1e-10));
+
+        fused.zero_grad();
+        for (auto &p: pa)
+            for (auto g: p->grad) assert(g == 0);
+    }
+
+    {
+        // The result does not depend on the split of the kernel across threads
+        tensor::nn::MLP<T> a(widths, 0.8), b(widths, 0.8);
+        tensor::nn::copy_params(a, b);
+        tensor::optim::FusedAdam<T> serial(a.getParams(), lr, beta1, beta2, eps, 1e-3);
+        tensor::optim::FusedAdam<T> split(b.getParams(), lr, beta1, beta2, eps, 1e-3);
+        train(a, serial, 5);
+        tensor::parallel::set_num_threads(4);
+        tensor::parallel::set_grain_size(8);
+        train(b, split, 5);
+        auto pa = a.getParams(), pb = b.getParams();
+        for (size_t i = 0; i < pa.size(); ++i)
+            for (size_t j = 0; j < pa[i]->data.size(); ++j) assert(approx(pa[i]->data[j], pb[i]->data[j]));
+    }
+
+    std::cout << "Fused Adam tests passed!" << std::endl;
+    return 0;
+}
@@ -105,5 +105,34 @@ int main() {
         y->backward();
     }
 
+    {
+        auto a = std::make_shared<Tensor<double>>(Tensor<double>::Shape{2}, std::vector<double>{3.0, 1.0}, true);
+        auto b = std::make_shared<Tensor<double>>(Tensor<double>::Shape{2}, std::vector<double>{2.0, 4.0}, true);
+
+        // y = a / b + 1 - (-a) - b
+        auto y = a / b + 1.0 - (-a) - b;
+        y->backward();
+        assert(approx(y->data[0], 1.5 + 1.0 + 3.0 - 2.0));
+        assert(approx(y->data[1], 0.25 + 1.0 + 1.0 - 4.0));
+
+        // dy/da = 1/b + 1, dy/db = -a/b^2 - 1, d2y/db2 = 2a/b^3
+        assert(approx(a->grad[0], 1.5));
+        assert(approx(a->grad[1], 1.25));
+        assert(approx(b->grad[0], -1.75));
+        assert(approx(b->grad[1], -1.0 / 16.0 - 1.0));
+        assert(approx(a->hess[0], 0.0));
+        assert(approx(b->hess[0], 0.75));
+        assert(approx(b->hess[1], 2.0 / 64.0));
+    }
+
+    {
+        auto x = std::make_shared<Tensor<double>>(Tensor<double>::Shape{1}, std::vector<double>{2.0}, true);
+        auto y = 1.0 / x - x / 4.0 + (3.0 - x);
+        y->backward();
+        assert(approx(y->data[0], 0.5 - 0.5 + 1.0));
+        assert(approx(x->grad[0], -0.25 - 0.25 - 1.0));
+        assert(approx(x->hess[0], 0.25));
+    }
+
     std::cout << "All tests passed!\n";
 }
@@ -0,0 +1,73 @@
+#include <iostream>
+#include <cassert>
+#include "tensor.hpp"
+
+bool approx(double a, double b, double tol = 1e-9) {
+    return std::abs(a - b) < tol;
+}
+
+using D = tensor::Dual<double>;
+
+/// Same architecture on any element type
+const std::vector<size_t> widths{3, 8, 8, 1};
+
+int main() {
+    tensor::set_seed(17);
+    const size_t N = 6, d = 3;
+    auto x = tensor::uniform<double>({N, d}, -1.0, 1.0);
+
+    const auto act = tensor::nn::Activation::Softplus;
+    tensor::nn::MLP<double> net(widths, 0.8, act);
+    tensor::nn::MLP<D> net_dual(widths, 0.8, act);
+    tensor::nn::copy_params(net, net_dual);
+
+    auto H = tensor::nn::input_hessian<double>(net_dual, x);
+    assert((H->shape == Tensor<double>::Shape{N, d, d}));
+    auto at = [&](size_t n, size_t i, size_t j) { return H->data[(n * d + i) * d + j]; };
+
+    // The trace is the exact Laplacian
+    auto ref = tensor::nn::forward_laplacian<double>(net, x);
+    for (size_t n = 0; n < N; ++n) {
+        double trace = 0;
+        for (size_t i = 0; i < d; ++i) trace += at(n, i, i);
+        assert(approx(trace, ref.L->data[n]));
+    }
+
+    // Every entry matches a central difference of the exact Jacobian
+    const double h = 1e-5;
+    for (size_t j = 0; j < d; ++j) {
+        auto xp = std::make_shared<Tensor<double>>(x->shape, x->data);
+        auto xm = std::make_shared<Tensor<double>>(x->shape, x->data);
+        for (size_t n = 0; n < N; ++n) {
+            xp->data[n * d + j] += h;
+            xm->data[n * d + j] -= h;
+        }
+        auto Jp = tensor::nn::forward_laplacian<double>(net, xp).J;
+        auto Jm = tensor::nn::forward_laplacian<double>(net, xm).J;
+        for (size_t n = 0; n < N; ++n) {
+            for (size_t i = 0; i < d; ++i) {
+                assert(approx(at(n, i, j), (Jp->data[i * N + n] - Jm->data[i * N + n]) / (2 * h), 1e-6));
+                assert(approx(at(n, i, j), at(n, j, i), 1e-12));
+            }
+        }
+    }
+
+    // Selected entries, including a repeated column
+    auto parts = tensor::nn::mixed_partials<double>(net_dual, x, {{0, 1}, {2, 2}, {1, 0}, {2, 0}});
+    assert(parts.size() == 4);
+    for (size_t n = 0; n < N; ++n) {
+        assert(approx(parts[0]->data[n], at(n, 0, 1), 1e-12));
+        assert(approx(parts[1]->data[n], at(n, 2, 2), 1e-12));
+        assert(approx(parts[2]->data[n], at(n, 1, 0), 1e-12));
+        assert(approx(parts[3]->data[n], at(n, 2, 0), 1e-12));
+    }
+
+    // The parameters are left untouched
+    for (auto &p: net_dual.getParams()) {
+        assert(p->requires_grad);
+        for (auto &g: p->grad) assert(g.val == 0.0 && g.eps[0] == 0.0);
+    }
+
+    std::cout << "Input Hessian tests passed!" << std::endl;
+    return 0;
+}
@@ -0,0 +1,121 @@
+#include <iostream>
+#include <memory>
+#include <cassert>
+#include <atomic>
+#include <mutex>
+#include <set>
+#include <thread>
+#include "tensor.hpp"
+
+bool approx(double a, double b, double tol = 1e-12) {
+    return std::abs(a - b) < tol;
+}
+
+using T = double;
+
+/// Layer widths of the network of the tests
+const std::vector<size_t> widths{2, 8, 1};
+
+int main() {
+    using namespace tensor::ops;
+    namespace par = tensor::parallel;
+
+    tensor::set_seed(3);
+    const size_t N = 200, B = 16;
+    auto x = tensor::uniform<T>({N, 2}, -1.0, 1.0);
+    auto y = tensor::zeros<T>({N, 1});
+    for (size_t i = 0; i < N; ++i) y->data[i] = x->data[2 * i] * x->data[2 * i + 1];
+
+    auto batch_loss = [&](const tensor::nn::Model<T> &net, size_t, tensor::Philox &rng) {
+        std::uniform_int_distribution<size_t> pick(0, N - 1);
+        std::vector<size_t> rows(B);
+        for (auto &r: rows) r = pick(rng);
+        return mean(pow(net(index_select(x, 0, rows)) - index_select(y, 0, rows), 2));
+    };
+
+    auto full_loss = [&](const tensor::nn::Model<T> &net) {
+        return mean(pow(net(x) - y, 2))->data[0];
+    };
+
+    {
+        // A single worker is plain sequential SGD
+        tensor::set_seed(5);
+        tensor::nn::MLP<T> reference(widths);
+        tensor::set_seed(5);
+        tensor::nn::MLP<T> model(widths);
+
+        par::HogwildOptions<T> options;
+        options.steps_per_worker = 20;
+        options.lr = 0.1;
+        options.seed = 7;
+        par::Hogwild<T> hogwild(model, []() { return std::make_unique<tensor::nn::MLP<T>>(widths); }, options);
+        auto stats = hogwild.run(batch_loss);
+        assert(stats.updates == 20);
+        assert(stats.max_staleness == 0);
+
+        tensor::optim::SGD<T> sgd(reference.getParams(), 0.1);
+        tensor::Philox rng(7);
+        for (int step = 0; step < 20; ++step) {
+            sgd.zero_grad();
+            batch_loss(reference, 0, rng)->backward();
+            sgd.step();
+        }
+        auto p = model.getParams(), q = reference.getParams();
+        for (size_t i = 0; i < p.size(); ++i) {
+            for (size_t j = 0; j < p[i]->data.size(); ++j) assert(approx(p[i]->data[j], q[i]->data[j]));
+        }
+    }
+
+    {
+        // Several workers updating the shared parameters with Adam
+        par::set_num_threads(4);
+        tensor::set_seed(5);
+        tensor::nn::MLP<T> model(widths);
+        const T before = full_loss(model);
+
+        par::HogwildOptions<T> options;
+        options.num_workers = 4;
+        options.steps_per_worker = 100;
+        options.rule = par::HogwildRule::Adam;
+        options.lr = 1e-2;
+        par::Hogwild<T> hogwild(model, []() { return std::make_unique<tensor::nn::MLP<T>>(widths); }, options);
+        auto stats = hogwild.run(batch_loss);
+        assert(stats.updates == 400);
+        assert(stats.max_staleness < 400);
+        assert(stats.mean_staleness <= stats.max_staleness);
+        assert(full_loss(model) < before);
+    }
+
+    {
+        // The workers are dedicated threads, even with a single pool thread
+        par::set_num_threads(1);
+        tensor::set_seed(5);
+        tensor::nn::MLP<T> model(widths);
+
+        par::HogwildOptions<T> options;
+        options.num_workers = 4;
+        options.steps_per_worker = 5;
+        par::Hogwild<T> hogwild(model, []() { return std::make_unique<tensor::nn::MLP<T>>(widths); }, options);
+
+        // Every worker waits in its first batch until all of them have started
+        std::atomic<size_t> started{0};
+        std::mutex ids_mutex;
+        std::set<std::thread::id> ids;
+        auto stats = hogwild.run([&](const tensor::nn::Model<T> &net, size_t w, tensor::Philox &rng) {
+            {
+                std::lock_guard<std::mutex> lock(ids_mutex);
+                ids.insert(std::this_thread::get_id());
+            }
+            if (started.fetch_add(1) < options.num_workers) {
+                while (started.load() < options.num_workers) std::this_thread::yield();
+            }
+            return batch_loss(net, w, rng);
+        });
+        assert(stats.updates == 20);
+        assert(ids.size() == 4);
+        assert(!ids.count(std::this_thread::get_id()));
+        par::set_num_threads(4);
+    }
+
+    std::cout << "Hogwild tests passed!\n";
+}
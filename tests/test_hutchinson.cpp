@@ -0,0 +1,76 @@
+#include <iostream>
+#include <cassert>
+#include "tensor.hpp"
+
+bool approx(double a, double b, double tol = 1e-9) {
+    return std::abs(a - b) < tol;
+}
+
+int main() {
+    using namespace tensor::ops;
+    tensor::set_seed(23);
+
+    {
+        // Probes are balanced signs
+        tensor::Philox rng(1);
+        auto v = tensor::nn::rademacher<double>({1000, 10}, rng);
+        double total = 0;
+        for (auto e: v->data) {
+            assert(e == 1.0 || e == -1.0);
+            total += e;
+        }
+        assert(std::abs(total) < 400);
+    }
+
+    {
+        // In one dimension v^2 = 1 and a single probe is exact
+        tensor::nn::MLP<double> net({1, 16, 16, 1}, 0.5);
+        auto x = tensor::uniform<double>({8, 1}, -1.0, 1.0);
+        auto est = tensor::nn::hutchinson_laplacian<double>(net, x, 1);
+        auto exact = tensor::nn::laplacian<double>(net, x);
+        for (size_t n = 0; n < 8; ++n) assert(approx(est->data[n], exact->data[n]));
+    }
+
+    {
+        // In 20 dimensions the estimate stays within a few standard deviations of the exact value
+        const size_t d = 20, N = 4, probes = 2000;
+        tensor::nn::MLP<double> net({d, 16, 16, 1}, 0.5);
+        tensor::nn::MLP<tensor::Dual<double>> net_dual({d, 16, 16, 1}, 0.5);
+        tensor::nn::copy_params(net, net_dual);
+        auto x = tensor::uniform<double>({N, d}, -1.0, 1.0);
+
+        tensor::Philox rng(7);
+        auto est = tensor::nn::hutchinson_laplacian<double>(net, x, probes, rng);
+        auto exact = tensor::nn::laplacian<double>(net, x);
+        auto H = tensor::nn::input_hessian<double>(net_dual, x);
+        for (size_t n = 0; n < N; ++n) {
+            double off = 0;
+            for (size_t i = 0; i < d; ++i)
+                for (size_t j = 0; j < d; ++j)
+                    if (i != j) off += std::pow(H->data[(n * d + i) * d + j], 2);
+            double sigma = std::sqrt(2 * off / probes);
+            assert(std::abs(est->data[n] - exact->data[n]) < 5 * sigma + 1e-12);
+        }
+
+        // With fixed probes the estimate is a graph node, trainable like the exact Laplacian
+        auto loss_of = [&]() {
+            tensor::Philox probe_rng(3);
+            return mean(pow(tensor::nn::hutchinson_laplacian<double>(net, x, 4, probe_rng), 2));
+        };
+        loss_of()->backward();
+        for (auto &p: net.getParams()) {
+            for (size_t j = 0; j < p->data.size(); j += 37) {
+                const double old = p->data[j], eps = 1e-6;
+                p->data[j] = old + eps;
+                double lp = loss_of()->data[0];
+                p->data[j] = old - eps;
+                double lm = loss_of()->data[0];
+                p->data[j] = old;
+                assert(approx(p->grad[j], (lp - lm) / (2 * eps), 1e-6));
+            }
+        }
+    }
+
+    std::cout << "Hutchinson estimator tests passed!" << std::endl;
+    return 0;
+}
@@ -0,0 +1,83 @@
+#include <iostream>
+#include <cassert>
+#include "tensor.hpp"
+
+bool approx(double a, double b, double tol = 1e-6) {
+    return std::abs(a - b) < tol;
+}
+
+/// Layer widths of the network of the tests
+const std::vector<size_t> widths{2, 8, 1};
+
+int main() {
+    using namespace tensor::ops;
+    using D1 = tensor::Dual<double, 1>;
+    using D2 = tensor::Dual<double, 2>;
+
+    tensor::set_seed(31);
+    auto x = tensor::uniform<double>({20, 2}, -1.0, 1.0);
+    auto y = tensor::uniform<double>({20, 1}, -1.0, 1.0);
+
+    tensor::nn::MLP<double> net(widths, 0.7);
+    auto params = net.getParams();
+
+    // The loss is written once for any element type
+    auto loss_fn = [&](const auto &model) {
+        using D = typename std::remove_cvref_t<decltype(model.getParams()[0]->data)>::value_type;
+        return mean(pow(model(tensor::lift<D>(x)) - tensor::lift<D>(y), 2));
+    };
+    auto gradient = [&]() {
+        for (auto &p: params) p->zero_grad();
+        loss_fn(net)->backward();
+        std::vector<double> g;
+        for (auto &p: params) g.insert(g.end(), p->grad.begin(), p->grad.end());
+        return g;
+    };
+
+    auto random_direction = [&]() {
+        std::vector<TensorS<double>> v;
+        for (auto &p: params) v.push_back(tensor::uniform<double>(p->shape, -1.0, 1.0));
+        return v;
+    };
+    auto v0 = random_direction(), v1 = random_direction();
+
+    // Batch of two vectors sharing one forward pass
+    tensor::nn::MLP<D2> net2(widths, 0.7);
+    auto result = tensor::nn::hvp(net2, loss_fn, params, {v0, v1});
+    assert(result.hv.size() == 2);
+
+    auto g = gradient();
+    assert(approx(result.loss, loss_fn(net)->data[0], 1e-12));
+    for (size_t i = 0, k = 0; i < params.size(); ++i)
+        for (size_t j = 0; j < params[i]->data.size(); ++j, ++k) assert(approx(result.grad[i]->data[j], g[k], 1e-12));
+
+    for (size_t m = 0; m < 2; ++m) {
+        const auto &v = m == 0 ? v0 : v1;
+
+        // Central difference of the gradient along v
+        const double eps = 1e-5;
+        auto shift = [&](double s) {
+            for (size_t i = 0; i < params.size(); ++i)
+                for (size_t j = 0; j < params[i]->data.size(); ++j) params[i]->data[j] += s * v[i]->data[j];
+        };
+        shift(eps);
+        auto gp = gradient();
+        shift(-2 * eps);
+        auto gm = gradient();
+        shift(eps);
+
+        for (size_t i = 0, k = 0; i < params.size(); ++i)
+            for (size_t j = 0; j < params[i]->data.size(); ++j, ++k)
+                assert(approx(result.hv[m][i]->data[j], (gp[k] - gm[k]) / (2 * eps)));
+    }
+
+    // A single vector gives the same product as the batch
+    tensor::nn::MLP<D1> net1(widths, 0.7);
+    auto single = tensor::nn::hvp(net1, loss_fn, params, {v1});
+    for (size_t i = 0; i < params.size(); ++i)
+        for (size_t j = 0; j < params[i]->data.size(); ++j)
+            assert(approx(single.hv[0][i]->data[j], result.hv[1][i]->data[j], 1e-12));
+
+    std::cout << "Hessian-vector product tests passed!" << std::endl;
+    return 0;
+}
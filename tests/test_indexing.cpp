@@ -0,0 +1,81 @@
+#include <iostream>
+#include <memory>
+#include <cassert>
+#include "tensor.hpp"
+
+bool approx(double a, double b, double tol = 1e-6) {
+    return std::abs(a - b) < tol;
+}
+
+int main() {
+    using namespace tensor::ops;
+    using T = double;
+
+    auto x = std::make_shared<Tensor<T>>(
+            Tensor<T>::Shape{3, 2},
+            std::vector<T>{1.0, 2.0, 3.0, 4.0, 5.0, 6.0},
+            true
+    );
+
+    {
+        auto y = index_select(x, 0, {2, 0, 2});
+        assert((y->shape == Tensor<T>::Shape{3, 2}));
+        std::vector<T> expected{5.0, 6.0, 1.0, 2.0, 5.0, 6.0};
+        for (size_t i = 0; i < 6; ++i) assert(approx(y->data[i], expected[i]));
+
+        auto loss = sum(pow(y, 2));
+        loss->backward();
+        // Row 2 is selected twice, row 1 never
+        std::vector<T> expected_grad{2.0, 4.0, 0.0, 0.0, 20.0, 24.0};
+        for (size_t i = 0; i < 6; ++i) assert(approx(x->grad[i], expected_grad[i]));
+        assert(approx(x->hess[0], 2.0));
+        assert(approx(x->hess[4], 4.0));
+    }
+
+    {
+        x->zero_grad();
+        auto z = tensor::ones<T>({3, 1}, true);
+        auto y = concat<T>({x, z}, 1);
+        assert((y->shape == Tensor<T>::Shape{3, 3}));
+        std::vector<T> expected{1.0, 2.0, 1.0, 3.0, 4.0, 1.0, 5.0, 6.0, 1.0};
+        for (size_t i = 0; i < 9; ++i) assert(approx(y->data[i], expected[i]));
+
+        auto w = std::make_shared<Tensor<T>>(Tensor<T>::Shape{3}, std::vector<T>{1.0, 2.0, 3.0});
+        auto loss = sum(y * w);
+        loss->backward();
+        for (size_t i = 0; i < 3; ++i) {
+            assert(approx(x->grad[i * 2], 1.0));
+            assert(approx(x->grad[i * 2 + 1], 2.0));
+            assert(approx(z->grad[i], 3.0));
+        }
+    }
+
+    {
+        x->zero_grad();
+        auto y = gather(x, 1, {1, 1, 0, 1, 0, 0}, {3, 2});
+        std::vector<T> expected{2.0, 2.0, 3.0, 4.0, 5.0, 5.0};
+        for (size_t i = 0; i < 6; ++i) assert(approx(y->data[i], expected[i]));
+
+        y->backward();
+        std::vector<T> expected_grad{0.0, 2.0, 1.0, 1.0, 2.0, 0.0};
+        for (size_t i = 0; i < 6; ++i) assert(approx(x->grad[i], expected_grad[i]));
+    }
+
+    {
+        x->zero_grad();
+        auto src = std::make_shared<Tensor<T>>(Tensor<T>::Shape{2, 2}, std::vector<T>{10.0, 20.0, 30.0, 40.0}, true);
+        auto y = scatter_add(x, 0, {2, 0, 2, 2}, src);
+        std::vector<T> expected{1.0, 22.0, 3.0, 4.0, 45.0, 46.0};
+        for (size_t i = 0; i < 6; ++i) assert(approx(y->data[i], expected[i]));
+
+        auto loss = sum(pow(y, 2));
+        loss->backward();
+        for (size_t i = 0; i < 6; ++i) assert(approx(x->grad[i], 2.0 * expected[i]));
+        assert(approx(src->grad[0], 90.0));
+        assert(approx(src->grad[1], 44.0));
+        assert(approx(src->grad[3], 92.0));
+        assert(approx(src->hess[2], 2.0));
+    }
+
+    std::cout << "Indexing tests passed!\n";
+}
@@ -0,0 +1,94 @@
+#include <iostream>
+#include <cassert>
+#include "tensor.hpp"
+
+bool approx(double a, double b, double tol = 1e-6) {
+    return std::abs(a - b) < tol;
+}
+
+using T = double;
+using tensor::nn::Activation;
+
+/// Network with 3 inputs and 2 outputs
+const std::vector<size_t> widths{3, 6, 6, 2};
+
+int main() {
+    using namespace tensor::ops;
+
+    tensor::set_seed(7);
+    const size_t N = 4, d = 3, K = 2;
+    auto x = tensor::uniform<T>({N, d}, -1.0, 1.0);
+
+    for (Activation act: {Activation::Tanh, Activation::Sin, Activation::Sigmoid, Activation::Softplus,
+                          Activation::Swish}) {
+        tensor::nn::MLP<T> net(widths, 0.7, act);
+        auto state = tensor::nn::forward_laplacian<T>(net, x);
+        assert((state.J->shape == Tensor<T>::Shape{d, N, K}));
+        assert((state.L->shape == Tensor<T>::Shape{N, K}));
+
+        auto eval = [&](size_t i, size_t k, T h) {
+            auto xp = std::make_shared<Tensor<T>>(x->shape, x->data);
+            xp->data[i * d + k] += h;
+            return net(xp);
+        };
+
+        // Value matches the ordinary forward pass, J and L match central differences
+        auto u = net(x);
+        const T h = 1e-4;
+        for (size_t i = 0; i < N; ++i) {
+            for (size_t c = 0; c < K; ++c) {
+                assert(approx(state.u->data[i * K + c], u->data[i * K + c], 1e-12));
+                T lap = 0;
+                for (size_t k = 0; k < d; ++k) {
+                    T up = eval(i, k, h)->data[i * K + c], um = eval(i, k, -h)->data[i * K + c];
+                    assert(approx(state.J->data[(k * N + i) * K + c], (up - um) / (2 * h)));
+                    lap += (up - 2 * u->data[i * K + c] + um) / (h * h);
+                }
+                assert(approx(state.L->data[i * K + c], lap, 1e-4));
+            }
+        }
+
+        // The residual is a graph node: its gradient matches finite differences in the parameters
+        auto loss_of = [&]() { return mean(pow(tensor::nn::laplacian<T>(net, x), 2)); };
+        for (auto &p: net.getParams()) p->zero_grad();
+        loss_of()->backward();
+        for (auto &p: net.getParams()) {
+            for (size_t j = 0; j < p->data.size(); j += 5) {
+                const T old = p->data[j], eps = 1e-6;
+                p->data[j] = old + eps;
+                T lp = loss_of()->data[0];
+                p->data[j] = old - eps;
+                T lm = loss_of()->data[0];
+                p->data[j] = old;
+                assert(approx(p->grad[j], (lp - lm) / (2 * eps), 1e-6));
+            }
+        }
+    }
+
+    {
+        // ReLU networks are piecewise linear: the Laplacian vanishes and J is the gradient
+        tensor::nn::MLP<T> net({3, 5, 1}, 1.0, Activation::Relu);
+        auto xg = std::make_shared<Tensor<T>>(x->shape, x->data, true);
+        net(xg)->backward();
+        auto state = tensor::nn::forward_laplacian<T>(net, x);
+        for (size_t i = 0; i < N; ++i) {
+            assert(approx(state.L->data[i], 0.0, 1e-12));
+            for (size_t k = 0; k < d; ++k) assert(approx(state.J->data[k * N + i], xg->grad[i * d + k], 1e-12));
+        }
+    }
+
+    {
+        // Models without a forward-Laplacian pass report it
+        struct Plain : tensor::nn::Model<T> {
+            tensor::nn::Linear<T> l{3, 1};
+            TensorS<T> operator()(const TensorS<T> &u) const override { return l(u); }
+            std::vector<TensorS<T>> getParams() const override { return l.getParams(); }
+        } net;
+        bool thrown = false;
+        try { tensor::nn::laplacian<T>(net, x); } catch (const std::runtime_error &) { thrown = true; }
+        assert(thrown);
+    }
+
+    std::cout << "Forward Laplacian tests passed!" << std::endl;
+    return 0;
+}
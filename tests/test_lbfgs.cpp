@@ -0,0 +1,108 @@
+#include <iostream>
+#include <cassert>
+#include "tensor.hpp"
+
+bool approx(double a, double b, double tol = 1e-6) {
+    return std::abs(a - b) < tol;
+}
+
+using T = double;
+
+/// Layer widths of the network of the tests
+const std::vector<size_t> widths{1, 16, 1};
+
+int main() {
+    using namespace tensor::ops;
+    tensor::set_seed(49);
+
+    {
+        // Rosenbrock function, gradient written by the closure
+        auto p = std::make_shared<Tensor<T>>(Tensor<T>::Shape{2}, std::vector<T>{-1.2, 1.0}, true);
+        size_t evaluations = 0;
+        auto rosenbrock = [&]() {
+            ++evaluations;
+            const T x = p->data[0], y = p->data[1];
+            p->grad[0] = -2 * (1 - x) - 400 * x * (y - x * x);
+            p->grad[1] = 200 * (y - x * x);
+            return (1 - x) * (1 - x) + 100 * (y - x * x) * (y - x * x);
+        };
+
+        tensor::optim::LBFGS<T> lbfgs({p}, 1.0, 10, 100);
+        lbfgs.step(rosenbrock);
+        assert(approx(p->data[0], 1.0, 1e-5) && approx(p->data[1], 1.0, 1e-5));
+        assert(evaluations < 100);
+
+        // step() alone cannot reevaluate the loss
+        bool thrown = false;
+        try { lbfgs.step(); } catch (const std::runtime_error &) { thrown = true; }
+        assert(thrown);
+    }
+
+    {
+        // Convex quadratic 1/2 x^T A x - b^T x without line search converges to A^-1 b
+        auto p = std::make_shared<Tensor<T>>(Tensor<T>::Shape{3}, std::vector<T>{0, 0, 0}, true);
+        const T A[3][3] = {{4, 1, 0}, {1, 3, 1}, {0, 1, 2}};
+        const T b[3] = {1, 2, 3};
+        auto quadratic = [&]() {
+            T f = 0;
+            for (size_t i = 0; i < 3; ++i) {
+                T Ax = 0;
+                for (size_t j = 0; j < 3; ++j) Ax += A[i][j] * p->data[j];
+                p->grad[i] = Ax - b[i];
+                f += 0.5 * p->data[i] * Ax - b[i] * p->data[i];
+            }
+            return f;
+        };
+        tensor::optim::LBFGS<T> lbfgs({p}, 1.0, 5, 200, false, 1e-12, 1e-20);
+        for (int s = 0; s < 3; ++s) lbfgs.step(quadratic);
+        // The gradient A x - b vanishes at the minimum
+        quadratic();
+        for (size_t i = 0; i < 3; ++i) assert(approx(p->grad[i], 0.0));
+    }
+
+    {
+        // Refining a network trained by Adam
+        auto x = tensor::uniform<T>({64, 1}, -1.0, 1.0);
+        auto y = tensor::zeros<T>({64, 1});
+        for (size_t i = 0; i < 64; ++i) y->data[i] = std::sin(3 * x->data[i]);
+        tensor::nn::MLP<T> net(widths, 0.8);
+        auto loss_fn = [&]() {
+            auto loss = mean(pow(net(x) - y, 2));
+            loss->backward();
+            return loss->data[0];
+        };
+
+        tensor::optim::Adam<T> adam(net.getParams(), 1e-2, 0.9, 0.999, 1e-8, 0.0);
+        for (int s = 0; s < 200; ++s) {
+            adam.zero_grad();
+            loss_fn();
+            adam.step();
+        }
+        adam.zero_grad();
+        const T after_adam = loss_fn();
+
+        tensor::optim::LBFGS<T> lbfgs(net.getParams());
+        T previous = after_adam;
+        for (int s = 0; s < 10; ++s) {
+            T loss = lbfgs.step(loss_fn);
+            assert(loss <= previous + 1e-12);
+            previous = loss;
+
+            // The returned loss is the one of the accepted parameters
+            lbfgs.zero_grad();
+            assert(approx(loss_fn(), loss, 1e-12));
+        }
+        assert(previous < 0.1 * after_adam);
+
+        // Also without line search, when the last iteration ends the step
+        tensor::optim::LBFGS<T> fixed(net.getParams(), 0.1, 10, 3, false);
+        for (int s = 0; s < 3; ++s) {
+            T loss = fixed.step(loss_fn);
+            fixed.zero_grad();
+            assert(approx(loss_fn(), loss, 1e-12));
+        }
+    }
+
+    std::cout << "L-BFGS tests passed!" << std::endl;
+    return 0;
+}
@@ -40,6 +40,58 @@ int main() {
         assert(approx(y->grad[i], expected_grad_B[i]));
     }
 
+    {
+        // Batched matmul with a shared right operand must match per-batch matmul
+        auto A = tensor::uniform<T>({3, 2, 4}, -1.f, 1.f, true);
+        auto W = tensor::uniform<T>({4, 5}, -1.f, 1.f, true);
+
+        auto C = bmm(A, W);
+        assert((C->shape == Tensor<T>::Shape{3, 2, 5}));
+        C->backward();
+
+        std::vector<T> W_grad(W->grad), W_hess(W->hess);
+        W->zero_grad();
+
+        for (size_t b = 0; b < 3; ++b) {
+            auto Ab = std::make_shared<Tensor<T>>(
+                    Tensor<T>::Shape{2, 4},
+                    std::vector<T>(A->data.begin() + b * 8, A->data.begin() + (b + 1) * 8),
+                    true
+            );
+            auto Cb = matmul(Ab, W);
+            Cb->backward();
+            for (size_t i = 0; i < 10; ++i) assert(approx(C->data[b * 10 + i], Cb->data[i]));
+            for (size_t i = 0; i < 8; ++i) {
+                assert(approx(A->grad[b * 8 + i], Ab->grad[i]));
+                assert(approx(A->hess[b * 8 + i], Ab->hess[i]));
+            }
+        }
+        for (size_t i = 0; i < W->grad.size(); ++i) {
+            assert(approx(W_grad[i], W->grad[i], 1e-5));
+            assert(approx(W_hess[i], W->hess[i], 1e-5));
+        }
+    }
+
+    {
+        // Batched matmul with a shared left operand
+        auto A = std::make_shared<Tensor<T>>(Tensor<T>::Shape{1, 2}, std::vector<T>{1.0, 2.0}, true);
+        auto B = std::make_shared<Tensor<T>>(
+                Tensor<T>::Shape{2, 2, 1},
+                std::vector<T>{1.0, 2.0, 3.0, 4.0},
+                true
+        );
+        auto C = bmm(A, B);
+        C->backward();
+
+        assert(approx(C->data[0], 5.0));
+        assert(approx(C->data[1], 11.0));
+        assert(approx(A->grad[0], 4.0));
+        assert(approx(A->grad[1], 6.0));
+        assert(approx(A->hess[0], 0.0));
+        assert(approx(B->grad[0], 1.0));
+        assert(approx(B->grad[3], 2.0));
+    }
+
     std::cout << "Matmul tests passed!\n";
 
     return 0;
@@ -0,0 +1,113 @@
+#include <iostream>
+#include <memory>
+#include <cassert>
+#include "tensor.hpp"
+
+bool approx(double a, double b, double tol = 1e-9) {
+    return std::abs(a - b) < tol;
+}
+
+#ifdef USE_MPI
+
+using T = double;
+
+/// Layer widths of the network of the tests
+const std::vector<size_t> widths{2, 8, 1};
+
+int main(int argc, char **argv) {
+    using namespace tensor::ops;
+    namespace mpi = tensor::parallel::mpi;
+
+    mpi::Environment env(argc, argv);
+    const int rank = mpi::rank(), size = mpi::size();
+
+    // Same dataset on every rank, different initial weights
+    tensor::set_seed(3);
+    const size_t N = 101;
+    auto x = tensor::uniform<T>({N, 2}, -1.0, 1.0);
+    auto y = tensor::uniform<T>({N, 1}, -1.0, 1.0);
+
+    auto loss_fn = [&](const tensor::nn::MLP<T> &net, size_t lo, size_t hi) {
+        std::vector<size_t> rows;
+        for (size_t i = lo; i < hi; ++i) rows.push_back(i);
+        auto pred = net(index_select(x, 0, rows));
+        return mean(pow(pred - index_select(y, 0, rows), 2)) * (T(hi - lo) / N);
+    };
+
+    auto make_net = [&]() {
+        tensor::set_seed(10 + rank);
+        auto net = std::make_unique<tensor::nn::MLP<T>>(widths);
+        mpi::broadcast_params(net->getParams());
+        return net;
+    };
+
+    {
+        // Partitions cover the dataset
+        auto [lo, hi] = mpi::partition(N);
+        unsigned long count = hi - lo, total = 0;
+        MPI_Allreduce(&count, &total, 1, MPI_UNSIGNED_LONG, MPI_SUM, MPI_COMM_WORLD);
+        assert(total == N);
+    }
+
+    {
+        // All-reduced gradients equal the gradients of the full loss
+        auto net = make_net();
+        auto full = loss_fn(*net, 0, N);
+        full->backward();
+        std::vector<std::vector<T>> grads, hess;
+        for (auto &p: net->getParams()) {
+            grads.push_back(p->grad);
+            hess.push_back(p->hess);
+            p->zero_grad();
+        }
+
+        auto [lo, hi] = mpi::partition(N);
+        loss_fn(*net, lo, hi)->backward();
+        mpi::allreduce_gradients(net->getParams(), true);
+        auto params = net->getParams();
+        for (size_t i = 0; i < params.size(); ++i) {
+            for (size_t j = 0; j < params[i]->grad.size(); ++j) {
+                assert(approx(params[i]->grad[j], grads[i][j]));
+                assert(approx(params[i]->hess[j], hess[i][j]));
+            }
+        }
+    }
+
+    {
+        // Replicated and sharded optimizer state produce the same updates
+        auto train = [&](bool shard_state) {
+            auto net = make_net();
+            mpi::DistributedOptimizer<T> optim(net->getParams(), [](const std::vector<TensorS<T>> &params) {
+                return std::make_unique<tensor::optim::Adam<T>>(params, 1e-2, 0.9, 0.999, 1e-8, 0.0);
+            }, shard_state);
+            auto [lo, hi] = mpi::partition(N);
+            for (int epoch = 0; epoch < 10; ++epoch) {
+                optim.zero_grad();
+                loss_fn(*net, lo, hi)->backward();
+                optim.step();
+            }
+            std::vector<T> result;
+            for (auto &p: net->getParams()) result.insert(result.end(), p->data.begin(), p->data.end());
+            return result;
+        };
+
+        auto replicated = train(false);
+        auto sharded = train(true);
+        for (size_t i = 0; i < replicated.size(); ++i) assert(approx(replicated[i], sharded[i]));
+
+        // Every rank holds the same parameters
+        std::vector<T> root = replicated;
+        MPI_Bcast(root.data(), static_cast<int>(root.size()), MPI_DOUBLE, 0, MPI_COMM_WORLD);
+        assert(root == replicated);
+    }
+
+    if (rank == 0) std::cout << "MPI tests passed on " << size << " ranks!\n";
+}
+
+#else
+
+int main() {
+    std::cout << "MPI tests skipped (build with -DUSE_MPI)\n";
+}
+
+#endif
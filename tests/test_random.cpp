@@ -0,0 +1,96 @@
+#include <iostream>
+#include <memory>
+#include <cassert>
+#include <algorithm>
+#include "tensor.hpp"
+
+bool approx(double a, double b, double tol = 1e-6) {
+    return std::abs(a - b) < tol;
+}
+
+int main() {
+    using tensor::Philox;
+    namespace par = tensor::parallel;
+
+    {
+        // Known-answer tests of Philox4x32-10 (Random123)
+        auto r = Philox::philox({0, 0, 0, 0}, 0);
+        assert((r == Philox::Block{0x6627e8d5, 0xe169c58d, 0xbc57ac4c, 0x9b00dbd8}));
+        r = Philox::philox({0xffffffff, 0xffffffff, 0xffffffff, 0xffffffff}, 0xffffffffffffffffull);
+        assert((r == Philox::Block{0x408f276d, 0x41c83b0e, 0xa20bc7c6, 0x6d5451fd}));
+        r = Philox::philox({0x243f6a88, 0x85a308d3, 0x13198a2e, 0x03707344}, (uint64_t(0x299f31d0) << 32) | 0xa4093822);
+        assert((r == Philox::Block{0xd16cfe09, 0x94fdcceb, 0x5001e420, 0x24126ea1}));
+    }
+
+    {
+        // Skip-ahead matches drawing, and the offset can be restored
+        Philox a(42, 3), b(42, 3);
+        for (int i = 0; i < 1001; ++i) a();
+        b.discard(1001);
+        assert(a() == b());
+
+        auto offset = a.get_offset();
+        auto next = a();
+        a.set_offset(offset);
+        assert(a() == next);
+
+        // Streams are different sequences
+        Philox s0 = a.split(0), s1 = a.split(1);
+        int equal = 0;
+        for (int i = 0; i < 100; ++i) equal += s0() == s1();
+        assert(equal < 5);
+    }
+
+    {
+        // Filling does not depend on the number of threads
+        par::set_grain_size(16);
+        par::set_num_threads(1);
+        tensor::set_seed(9);
+        auto u1 = tensor::uniform<double>({1001}, -2.0, 3.0);
+        auto n1 = tensor::normal<float>({1001}, 1.f, 2.f);
+        auto p1 = tensor::random_perm(1001);
+
+        par::set_num_threads(4);
+        tensor::set_seed(9);
+        auto u4 = tensor::uniform<double>({1001}, -2.0, 3.0);
+        auto n4 = tensor::normal<float>({1001}, 1.f, 2.f);
+        auto p4 = tensor::random_perm(1001);
+        assert(u1->data == u4->data);
+        assert(n1->data == n4->data);
+        assert(p1 == p4);
+
+        // Resuming from a saved position reproduces the draws
+        auto offset = tensor::global_rng().get_offset();
+        auto next = tensor::uniform<double>({10});
+        tensor::global_rng().set_offset(offset);
+        assert(tensor::uniform<double>({10})->data == next->data);
+    }
+
+    {
+        // Moments of the distributions
+        tensor::set_seed(1);
+        const size_t n = 200000;
+        auto u = tensor::uniform<double>({n}, -1.0, 3.0);
+        assert(*std::min_element(u->data.begin(), u->data.end()) >= -1.0);
+        assert(*std::max_element(u->data.begin(), u->data.end()) < 3.0);
+        double mean = 0;
+        for (auto v: u->data) mean += v;
+        assert(approx(mean / n, 1.0, 1e-2));
+
+        auto z = tensor::normal<double>({n}, 2.0, 3.0);
+        double m = 0, var = 0;
+        for (auto v: z->data) m += v;
+        m /= n;
+        for (auto v: z->data) var += (v - m) * (v - m);
+        var /= n;
+        assert(approx(m, 2.0, 3e-2));
+        assert(approx(var, 9.0, 1e-1));
+
+        auto perm = tensor::random_perm(1000);
+        std::vector<size_t> sorted(perm);
+        std::sort(sorted.begin(), sorted.end());
+        for (size_t i = 0; i < sorted.size(); ++i) assert(sorted[i] == i);
+    }
+
+    std::cout << "Random tests passed!\n";
+}
@@ -0,0 +1,79 @@
+#include <iostream>
+#include <memory>
+#include <cassert>
+#include "tensor.hpp"
+
+bool approx(double a, double b, double tol = 1e-6) {
+    return std::abs(a - b) < tol;
+}
+
+int main() {
+    using namespace tensor::ops;
+    using T = double;
+
+    auto x = std::make_shared<Tensor<T>>(
+            Tensor<T>::Shape{2, 3},
+            std::vector<T>{1.0, 5.0, 3.0, 4.0, 2.0, 6.0},
+            true
+    );
+
+    {
+        auto y = sum(x, 0);
+        assert((y->shape == Tensor<T>::Shape{3}));
+        assert(approx(y->data[0], 5.0));
+        assert(approx(y->data[1], 7.0));
+        assert(approx(y->data[2], 9.0));
+
+        auto z = sum(x, 1, true);
+        assert((z->shape == Tensor<T>::Shape{2, 1}));
+        assert(approx(z->data[0], 9.0));
+        assert(approx(z->data[1], 12.0));
+    }
+
+    {
+        x->zero_grad();
+        auto y = sum(pow(mean(x, 1), 2));
+        y->backward();
+        // d/dx (mean_row)^2 = 2 * mean_row / 3, d2/dx2 = 2 / 9
+        assert(approx(y->data[0], 9.0 + 16.0));
+        assert(approx(x->grad[0], 2.0));
+        assert(approx(x->grad[5], 8.0 / 3.0));
+        assert(approx(x->hess[0], 2.0 / 9.0));
+    }
+
+    {
+        x->zero_grad();
+        auto y = max(x, 1);
+        y->backward();
+        assert(approx(y->data[0], 5.0));
+        assert(approx(y->data[1], 6.0));
+        std::vector<T> expected{0.0, 1.0, 0.0, 0.0, 0.0, 1.0};
+        for (size_t i = 0; i < 6; ++i) assert(approx(x->grad[i], expected[i]));
+    }
+
+    {
+        auto v = std::make_shared<Tensor<T>>(Tensor<T>::Shape{2}, std::vector<T>{3.0, 4.0}, true);
+        auto n = norm(v);
+        n->backward();
+        assert(approx(n->data[0], 5.0));
+        assert(approx(v->grad[0], 0.6));
+        assert(approx(v->grad[1], 0.8));
+        assert(approx(v->hess[0], (1.0 - 0.36) / 5.0));
+        assert(approx(v->hess[1], (1.0 - 0.64) / 5.0));
+    }
+
+    {
+        // Pairwise summation keeps the error small on long vectors
+        const size_t N = 1 << 22;
+        auto ones = tensor::ones<float>({N});
+        for (auto &v: ones->data) v = 0.1f;
+        auto s = sum(ones);
+        assert(std::abs(s->data[0] - 0.1 * N) / (0.1 * N) < 1e-5);
+
+        auto cols = tensor::ones<float>({N / 4, 4});
+        auto sc = sum(cols, 0);
+        for (size_t i = 0; i < 4; ++i) assert(sc->data[i] == float(N / 4));
+    }
+
+    std::cout << "Reduction tests passed!\n";
+}
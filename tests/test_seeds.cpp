@@ -0,0 +1,134 @@
+#include <iostream>
+#include <cassert>
+#include "tensor.hpp"
+
+bool approx(double a, double b, double tol = 1e-10) {
+    return std::abs(a - b) < tol;
+}
+
+using T = double;
+
+/// Three outputs (u, v, p) from two inputs
+const std::vector<size_t> widths{2, 10, 3};
+
+int main() {
+    using namespace tensor::ops;
+    tensor::set_seed(41);
+    const size_t N = 7, K = 3;
+    auto data = tensor::uniform<T>({N, 2}, -1.0, 1.0);
+    tensor::nn::MLP<T> net(widths, 0.8);
+
+    auto one_hot = [&](size_t k) {
+        std::vector<T> seed(N * K, T(0));
+        for (size_t n = 0; n < N; ++n) seed[n * K + k] = T(1);
+        return seed;
+    };
+
+    // Reference: one forward and backward per output, through index_select
+    std::vector<std::vector<T>> ref_grad, ref_hess;
+    for (size_t k = 0; k < K; ++k) {
+        auto x = std::make_shared<Tensor<T>>(data->shape, data->data, true);
+        sum(index_select(net(x), 1, {k}))->backward();
+        ref_grad.push_back(x->grad);
+        ref_hess.push_back(x->hess);
+    }
+
+    {
+        // A one-hot seed differentiates a single output
+        for (size_t k = 0; k < K; ++k) {
+            auto x = std::make_shared<Tensor<T>>(data->shape, data->data, true);
+            net(x)->backward(one_hot(k), {});
+            for (size_t i = 0; i < x->grad.size(); ++i) {
+                assert(approx(x->grad[i], ref_grad[k][i]));
+                assert(approx(x->hess[i], ref_hess[k][i]));
+            }
+        }
+
+        // The default backward is the all-ones seed
+        auto x = std::make_shared<Tensor<T>>(data->shape, data->data, true);
+        net(x)->backward(std::vector<T>(N * K, T(1)), std::vector<T>(N * K, T(0)));
+        for (size_t i = 0; i < x->grad.size(); ++i)
+            assert(approx(x->grad[i], ref_grad[0][i] + ref_grad[1][i] + ref_grad[2][i]));
+
+        // Seeds of the wrong size are rejected
+        bool thrown = false;
+        try { net(x)->backward(std::vector<T>(3, T(1)), {}); } catch (const std::runtime_error &) { thrown = true; }
+        assert(thrown);
+    }
+
+    {
+        // All outputs in one traversal with stacked seed channels
+        for (auto &p: net.getParams()) p->zero_grad();
+        auto x = std::make_shared<Tensor<T>>(data->shape, data->data, true);
+        auto out = net(x);
+        auto params = net.getParams();
+        std::vector<TensorS<T>> inputs{x, params[0]};
+        auto result = out->backward_channels({one_hot(0), one_hot(1), one_hot(2)}, inputs);
+        assert(result.size() == K);
+
+        for (size_t k = 0; k < K; ++k) {
+            for (size_t i = 0; i < x->data.size(); ++i) {
+                assert(approx(result[k][0].grad[i], ref_grad[k][i]));
+                assert(approx(result[k][0].hess[i], ref_hess[k][i]));
+            }
+        }
+
+        // Parameter derivatives per channel add up to those of the all-ones seed, and no grad is touched
+        for (auto &g: x->grad) assert(g == 0);
+        for (auto &g: params[0]->grad) assert(g == 0);
+        net(x)->backward();
+        for (size_t i = 0; i < params[0]->grad.size(); ++i) {
+            T total = result[0][1].grad[i] + result[1][1].grad[i] + result[2][1].grad[i];
+            assert(approx(total, params[0]->grad[i]));
+        }
+    }
+
+    {
+        // Every kernel with stacked channels, against one seeded backward per channel
+        auto x = tensor::uniform<T>({4, 3}, -1.0, 1.0, true);
+        auto w = tensor::uniform<T>({3, 5}, -1.0, 1.0, true);
+        auto v = tensor::uniform<T>({1, 5}, 0.5, 1.5, true);
+        auto batched = tensor::uniform<T>({2, 5, 3}, -1.0, 1.0, true);
+        auto A = tensor::sparse_from_coo<T>(4, 4, {0, 1, 1, 2, 3, 3}, {0, 0, 2, 3, 1, 3},
+                                            {1.5, -1.0, 2.0, 0.5, -2.0, 1.0}, true);
+        std::vector<TensorS<T>> inputs{x, w, v, batched, A->values};
+
+        size_t calls = 0;
+        auto build = [&]() {
+            auto h = tanh(broadcast_add(matmul(x, w), v));
+            h = spmm(A, sigmoid(h * v - v / (h + 3.0) + 2.0 / (v + 1.0)));
+            auto inner = h->grad_fn;
+            h->grad_fn = [inner, &calls]() { ++calls; inner(); };
+            auto c = concat<T>({sum(bmm(bmm(h, batched), w), 0), mean(bmm(h, batched), 0) - 1.0}, 1);
+            c = index_select(scatter_add(c, 1, {0, 2, 4, 6, 1, 3, 5, 7}, swish(index_select(x, 1, {0, 2})) * 0.5),
+                             0, {3, 0, 0, 2});
+            return concat<T>({norm(c, 1, true), max(c, 1, true), mean(c, 1, true),
+                              pow(gather(c, 1, {0, 7, 2, 3, 5, 5, 1, 0}, {4, 2}), 3)}, 1);
+        };
+
+        const size_t C = 3, size = build()->data.size();
+        std::vector<std::vector<T>> grads, hess;
+        for (size_t c = 0; c < C; ++c) {
+            grads.push_back(tensor::uniform<T>({size}, -1.0, 1.0)->data);
+            hess.push_back(tensor::uniform<T>({size}, -1.0, 1.0)->data);
+        }
+
+        calls = 0;
+        auto result = build()->backward_channels(grads, inputs, hess);
+        assert(calls == 1);
+
+        for (size_t c = 0; c < C; ++c) {
+            for (auto &t: inputs) t->zero_grad();
+            build()->backward(grads[c], hess[c]);
+            for (size_t i = 0; i < inputs.size(); ++i) {
+                for (size_t j = 0; j < inputs[i]->data.size(); ++j) {
+                    assert(approx(result[c][i].grad[j], inputs[i]->grad[j]));
+                    assert(approx(result[c][i].hess[j], inputs[i]->hess[j]));
+                }
+            }
+        }
+    }
+
+    std::cout << "Backward seed tests passed!" << std::endl;
+    return 0;
+}
@@ -0,0 +1,53 @@
+#include <iostream>
+#include <memory>
+#include <cassert>
+#include "tensor.hpp"
+
+bool approx(double a, double b, double tol = 1e-6) {
+    return std::abs(a - b) < tol;
+}
+
+int main() {
+    using namespace tensor::ops;
+    using T = double;
+
+    // 1D Laplacian stencil [-1 2 -1] on 4 nodes, plus a duplicated entry summed by the COO import
+    std::vector<size_t> row{0, 0, 1, 1, 1, 2, 2, 2, 3, 3, 3};
+    std::vector<size_t> col{0, 1, 0, 1, 2, 1, 2, 3, 2, 3, 3};
+    std::vector<T> val{2, -1, -1, 2, -1, -1, 2, -1, -1, 1, 1};
+    auto A = tensor::sparse_from_coo<T>(4, 4, row, col, val, true);
+    assert(A->nnz() == 10);
+
+    std::vector<T> dense{2, -1, 0, 0, -1, 2, -1, 0, 0, -1, 2, -1, 0, 0, -1, 2};
+    auto D = std::make_shared<Tensor<T>>(Tensor<T>::Shape{4, 4}, dense, true);
+
+    auto X = tensor::uniform<T>({4, 3}, -1.0, 1.0, true);
+    auto Y = spmm(A, X);
+    assert((Y->shape == Tensor<T>::Shape{4, 3}));
+
+    auto loss = sum(pow(Y, 2));
+    loss->backward();
+    std::vector<T> X_grad(X->grad), X_hess(X->hess);
+    X->zero_grad();
+
+    // Same computation with the dense operator
+    auto Yd = matmul(D, X);
+    for (size_t i = 0; i < Y->data.size(); ++i) assert(approx(Y->data[i], Yd->data[i]));
+    auto loss_d = sum(pow(Yd, 2));
+    loss_d->backward();
+
+    for (size_t i = 0; i < X->grad.size(); ++i) {
+        assert(approx(X_grad[i], X->grad[i]));
+        assert(approx(X_hess[i], X->hess[i]));
+    }
+
+    // Gradient of the non-zero values matches the dense gradient on the pattern
+    for (size_t r = 0; r < 4; ++r) {
+        for (size_t nz = A->row_ptr[r]; nz < A->row_ptr[r + 1]; ++nz) {
+            assert(approx(A->values->grad[nz], D->grad[r * 4 + A->col_idx[nz]]));
+            assert(approx(A->values->hess[nz], D->hess[r * 4 + A->col_idx[nz]]));
+        }
+    }
+
+    std::cout << "Sparse tests passed!\n";
+}
@@ -0,0 +1,101 @@
+#include <iostream>
+#include <cassert>
+#include "tensor.hpp"
+
+bool approx(double a, double b, double tol = 1e-8) {
+    return std::abs(a - b) < tol * (1 + std::abs(b));
+}
+
+/// Nested dual numbers carry the derivatives up to the fourth, used as reference
+using D1 = tensor::Dual<double>;
+using D4 = tensor::Dual<tensor::Dual<tensor::Dual<D1>>>;
+
+/// Univariate variable t = t0, seeded on every level
+template<typename D>
+D variable(double t0) {
+    if constexpr (std::is_same_v<D, double>) {
+        return t0;
+    } else {
+        using Inner = decltype(D::val);
+        return D(variable<Inner>(t0), {Inner(1.0)});
+    }
+}
+
+/// k-th derivative in t of a nested dual
+template<typename D>
+double derivative(const D &x, size_t k) {
+    if constexpr (std::is_same_v<D, double>) {
+        return x;
+    } else {
+        return k == 0 ? derivative(x.val, 0) : derivative(x.eps[0], k - 1);
+    }
+}
+
+using tensor::nn::Activation;
+
+/// Same architecture on any element type, with every activation
+const std::vector<size_t> widths{2, 6, 6, 1};
+const Activation activations[] = {Activation::Tanh, Activation::Sin, Activation::Sigmoid, Activation::Softplus,
+                                  Activation::Swish};
+
+int main() {
+    using namespace tensor::ops;
+
+    tensor::set_seed(5);
+    const size_t N = 5;
+    auto x = tensor::uniform<double>({N, 2}, -1.0, 1.0);
+
+    // Directional derivatives along x + t w, against nested duals
+    auto reference = [&](const tensor::nn::MLP<double> &net, Activation act, std::vector<double> w) {
+        tensor::nn::MLP<D4> ref(widths, 0.8, act);
+        tensor::nn::copy_params(net, ref);
+        auto t = variable<D4>(0.0);
+        auto xt = tensor::lift<D4>(x);
+        for (size_t i = 0; i < xt->data.size(); ++i) xt->data[i] = xt->data[i] + w[i % 2] * t;
+        return ref(xt);
+    };
+
+    for (auto act: activations) {
+        tensor::nn::MLP<double> net(widths, 0.8, act);
+        std::vector<double> w{0.6, -1.3};
+        auto dir = std::make_shared<Tensor<double>>(Tensor<double>::Shape{1, 2}, w);
+        auto derivs = tensor::nn::directional_derivatives<double>(net, x, dir, 4);
+        assert(derivs.size() == 5);
+
+        auto ref = reference(net, act, w);
+        for (size_t i = 0; i < N; ++i)
+            for (size_t k = 0; k <= 4; ++k) assert(approx(derivs[k]->data[i], derivative(ref->data[i], k)));
+
+        // Biharmonic operator: u_xxxx + 2 u_xxyy + u_yyyy, from axis and diagonal directions
+        auto bih = tensor::nn::biharmonic<double>(net, x);
+        auto ex = reference(net, act, {1, 0}), ey = reference(net, act, {0, 1});
+        auto ep = reference(net, act, {1, 1}), em = reference(net, act, {1, -1});
+        for (size_t i = 0; i < N; ++i) {
+            double dx = derivative(ex->data[i], 4), dy = derivative(ey->data[i], 4);
+            double xxyy = (derivative(ep->data[i], 4) + derivative(em->data[i], 4) - 2 * dx - 2 * dy) / 12;
+            assert(approx(bih->data[i], dx + dy + 2 * xxyy, 1e-7));
+        }
+    }
+
+    {
+        // The fourth derivative is a graph node: its gradient matches finite differences
+        tensor::nn::MLP<double> net(widths, 0.8);
+        auto dir = std::make_shared<Tensor<double>>(Tensor<double>::Shape{1, 2}, std::vector<double>{1.0, 0.5});
+        auto loss_of = [&]() { return mean(pow(tensor::nn::directional_derivatives<double>(net, x, dir, 4)[4], 2)); };
+        loss_of()->backward();
+        for (auto &p: net.getParams()) {
+            for (size_t j = 0; j < p->data.size(); j += 4) {
+                const double old = p->data[j], eps = 1e-6;
+                p->data[j] = old + eps;
+                double lp = loss_of()->data[0];
+                p->data[j] = old - eps;
+                double lm = loss_of()->data[0];
+                p->data[j] = old;
+                assert(approx(p->grad[j], (lp - lm) / (2 * eps), 1e-5));
+            }
+        }
+    }
+
+    std::cout << "Taylor mode tests passed!" << std::endl;
+    return 0;
+}
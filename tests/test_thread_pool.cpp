@@ -0,0 +1,92 @@
+#include <iostream>
+#include <memory>
+#include <cassert>
+#include <atomic>
+#include "tensor.hpp"
+
+bool approx(double a, double b, double tol = 1e-9) {
+    return std::abs(a - b) < tol;
+}
+
+int main() {
+    using namespace tensor::ops;
+    using T = double;
+    namespace par = tensor::parallel;
+
+    {
+        par::ThreadPool pool(4);
+        std::vector<std::atomic<int>> hits(1000);
+        pool.run_tasks(hits.size(), [&](size_t i) { hits[i]++; });
+        for (auto &h: hits) assert(h == 1);
+
+        // Nested regions run serially on the worker
+        std::atomic<int> total{0};
+        pool.run_tasks(8, [&](size_t) {
+            assert(par::ThreadPool::in_parallel_region());
+            pool.run_tasks(8, [&](size_t) { total++; });
+        });
+        assert(total == 64);
+
+        bool thrown = false;
+        try {
+            pool.run_tasks(16, [](size_t i) { if (i == 7) throw std::runtime_error("task failed"); });
+        } catch (const std::runtime_error &) {
+            thrown = true;
+        }
+        assert(thrown);
+    }
+
+    // Runs a small network with a tiny grain size and compares against a single thread
+    auto run = [](size_t threads) {
+        par::set_num_threads(threads);
+        par::set_grain_size(16);
+        tensor::set_seed(7);
+        auto x = tensor::uniform<T>({300, 3}, -1.0, 1.0, true);
+        auto W = tensor::normal<T>({3, 8}, 0.0, 1.0, true);
+        auto b = tensor::normal<T>({1, 8}, 0.0, 1.0, true);
+        auto h = broadcast_add(matmul(x, W), b);
+        auto y = sum(pow(tanh(h) * 2.0 - sigmoid(h * b + 1.0) / 3.0, 2), 1);
+        auto loss = mean(y);
+        loss->backward();
+        std::vector<T> result{loss->data[0]};
+        for (auto t: {x, W, b}) {
+            result.insert(result.end(), t->grad.begin(), t->grad.end());
+            result.insert(result.end(), t->hess.begin(), t->hess.end());
+        }
+        return result;
+    };
+
+    auto serial = run(1);
+    auto threaded = run(4);
+    assert(serial.size() == threaded.size());
+    for (size_t i = 0; i < serial.size(); ++i) assert(approx(serial[i], threaded[i]));
+
+    // Parallel backward of a loss with two branches sharing the parameters
+    auto two_branches = [](bool parallel) {
+        par::set_num_threads(4);
+        par::set_grain_size(1 << 15);
+        tensor::set_seed(11);
+        auto W = tensor::normal<T>({2, 16}, 0.0, 1.0, true);
+        auto b = tensor::normal<T>({1, 16}, 0.0, 1.0, true);
+        auto V = tensor::normal<T>({16, 1}, 0.0, 1.0, true);
+        auto x = tensor::uniform<T>({64, 2}, -1.0, 1.0, true);
+        auto xb = tensor::uniform<T>({32, 2}, -1.0, 1.0, false);
+        auto net = [&](TensorS<T> in) { return matmul(tanh(broadcast_add(matmul(in, W), b)), V); };
+        auto loss = mean(pow(net(x), 2)) * 0.5 + mean(pow(net(xb) - 1.0, 2));
+        loss->backward(true, parallel);
+        std::vector<T> result{loss->data[0]};
+        for (auto t: {W, b, V, x}) {
+            result.insert(result.end(), t->grad.begin(), t->grad.end());
+            result.insert(result.end(), t->hess.begin(), t->hess.end());
+        }
+        return result;
+    };
+
+    auto expected = two_branches(false);
+    for (int rep = 0; rep < 20; ++rep) {
+        auto result = two_branches(true);
+        for (size_t i = 0; i < expected.size(); ++i) assert(approx(result[i], expected[i]));
+    }
+
+    std::cout << "Thread pool tests passed!\n";
+}